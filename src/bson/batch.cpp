@@ -0,0 +1,55 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bson/batch.hpp"
+
+#include <thread>
+
+namespace bson {
+
+namespace {
+
+// Below this many records per thread, starting a thread costs more than it saves.
+const std::size_t kMinRecordsPerThread = 256;
+
+}  // namespace
+
+encoded_batch::encoded_batch() = default;
+encoded_batch::encoded_batch(encoded_batch&&) = default;
+encoded_batch& encoded_batch::operator=(encoded_batch&&) = default;
+encoded_batch::~encoded_batch() = default;
+
+const std::vector<document::view>& encoded_batch::views() const { return _views; }
+
+encoded_batch::const_iterator encoded_batch::begin() const { return _views.begin(); }
+
+encoded_batch::const_iterator encoded_batch::end() const { return _views.end(); }
+
+std::size_t encoded_batch::size() const { return _views.size(); }
+
+std::size_t encoded_batch::chunk_count(std::size_t records, std::size_t threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+
+    std::size_t useful = records / kMinRecordsPerThread;
+
+    if (threads > useful) {
+        threads = useful;
+    }
+
+    return threads ? threads : 1;
+}
+
+}  // namespace bson
@@ -0,0 +1,111 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "bson/document/arena.hpp"
+#include "bson/document/view.hpp"
+#include "bson/encoder.hpp"
+#include "bson/util/parallel.hpp"
+
+namespace bson {
+
+class encoded_batch;
+
+template <typename Range, typename Encode>
+encoded_batch encode_batch(const Range& records, Encode encode, std::size_t threads = 0);
+
+/// Documents encoded by encode_batch(), in the order of the records they came from. Owns their
+/// bytes, so the views stay valid for as long as the batch does, including across moves.
+class LIBMONGOCXX_EXPORT encoded_batch {
+   public:
+    using const_iterator = std::vector<document::view>::const_iterator;
+
+    encoded_batch();
+    encoded_batch(encoded_batch&& rhs);
+    encoded_batch& operator=(encoded_batch&& rhs);
+    ~encoded_batch();
+
+    const std::vector<document::view>& views() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    std::size_t size() const;
+
+   private:
+    template <typename Range, typename Encode>
+    friend encoded_batch encode_batch(const Range& records, Encode encode, std::size_t threads);
+
+    static std::size_t chunk_count(std::size_t records, std::size_t threads);
+
+    std::vector<document::arena> _arenas;
+    std::vector<document::view> _views;
+};
+
+/// Encodes a random access range of records into documents on several threads, ready to hand to
+/// model::insert_many or a bulk write.
+///
+/// The records are split into one contiguous chunk per thread. Each thread encodes its chunk with
+/// its own encoder and packs the results into its own arena, so threads share nothing while they
+/// work. The resulting views are in record order whatever the scheduling.
+///
+/// encode is called as encode(record, encoder&) and returns the view of the finished document,
+/// which is exactly the shape of bson::encode(const T&, encoder&) for mapped structs:
+///
+///   auto batch = bson::encode_batch(records, [](const record& r, bson::encoder& e) {
+///       return bson::encode(r, e);
+///   });
+///   collection.insert_many(model::insert_many{batch.views()});
+///
+/// threads defaults to the number of hardware threads. Small batches use fewer.
+template <typename Range, typename Encode>
+encoded_batch encode_batch(const Range& records, Encode encode, std::size_t threads) {
+    auto first = std::begin(records);
+    std::size_t n = static_cast<std::size_t>(std::distance(first, std::end(records)));
+    std::size_t chunks = encoded_batch::chunk_count(n, threads);
+
+    encoded_batch batch;
+    batch._arenas.resize(chunks);
+
+    util::run_parallel(chunks, [&](std::size_t chunk) {
+        std::size_t begin = n * chunk / chunks;
+        std::size_t end = n * (chunk + 1) / chunks;
+
+        encoder e;
+        document::arena& arena = batch._arenas[chunk];
+
+        for (auto it = first + begin; it != first + end; ++it) {
+            arena.push_back(encode(*it, e));
+        }
+    });
+
+    batch._views.reserve(n);
+
+    for (auto&& arena : batch._arenas) {
+        batch._views.insert(batch._views.end(), arena.begin(), arena.end());
+    }
+
+    return batch;
+}
+
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
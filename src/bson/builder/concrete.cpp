@@ -292,6 +292,10 @@ void concrete::value_append(string_or_literal value) {
     value_append(types::b_utf8{std::move(value)});
 }
 
+void concrete::value_append(const std::string& value) {
+    value_append(types::b_utf8{string_or_literal{value.c_str(), value.length()}});
+}
+
 void concrete::value_append(std::int32_t value) { value_append(types::b_int32{value}); }
 
 void concrete::value_append(const oid& value) { value_append(types::b_oid{value}); }
@@ -17,6 +17,7 @@
 #include "driver/config/prelude.hpp"
 
 #include <memory>
+#include <string>
 
 #include "bson/document.hpp"
 #include "bson/types.hpp"
@@ -70,6 +71,10 @@ class LIBMONGOCXX_EXPORT concrete {
 
     void value_append(string_or_literal value);
 
+    /// Values are copied into the document as they are appended, so strings are never owned here,
+    /// even temporaries.
+    void value_append(const std::string& value);
+
     template <std::size_t n>
     void value_append(const char (&v)[n]) {
         value_append(string_or_literal{v, n - 1});
@@ -0,0 +1,305 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "bson/document.hpp"
+#include "bson/key_table.hpp"
+#include "bson/mapping.hpp"
+#include "bson/oid.hpp"
+#include "bson/types.hpp"
+#include "driver/util/optional.hpp"
+
+namespace bson {
+
+enum class decode_error_code : std::uint8_t {
+    k_missing,
+    k_type_mismatch,
+};
+
+struct decode_error {
+    /// The key of the offending field, as declared in its mapping.
+    const char* key;
+    decode_error_code code;
+    /// The type found in the document, or k_eod for missing fields.
+    bson::type actual;
+};
+
+/// The outcome of decoding a document. Errors are collected rather than thrown, and decoding
+/// carries on past them, so one pass reports every missing or mistyped field.
+class decode_result {
+   public:
+    explicit operator bool() const { return _errors.empty(); }
+
+    const std::vector<decode_error>& errors() const { return _errors; }
+
+    void add(const char* key, decode_error_code code, bson::type actual) {
+        _errors.push_back(decode_error{key, code, actual});
+    }
+
+   private:
+    std::vector<decode_error> _errors;
+};
+
+/// Reads documents into mapped structs in a single pass over their elements.
+///
+/// The keys of each mapping are interned into a key_table, with field i getting id i, and every
+/// thread remembers the key order of the last document it decoded for each type. Documents that
+/// share a layout, as most in a collection do, then resolve each key with one string compare, and
+/// dispatch to its field by integer compares. Keys that are not part of the mapping are skipped.
+/// Every field that is not an optional must be present.
+class decoder {
+   public:
+    /// The largest number of fields a single mapping may declare.
+    static constexpr std::size_t k_max_fields = 256;
+
+    template <typename T>
+    static void fields(const document::view& view, T& out, decode_result& result) {
+        static_assert(mapping::traits<T>::field_count <= k_max_fields,
+                      "mapping declares more fields than the decoder supports");
+
+        static const key_table table = keys(out);
+        static thread_local key_table::order order{&table};
+
+        std::bitset<k_max_fields> seen;
+        std::size_t position = 0;
+
+        for (auto&& e : view) {
+            key_table::id_type id = order.find(position++, e.key_data());
+
+            if (id == key_table::k_npos) {
+                continue;
+            }
+
+            field_reader reader{&e, id, 0, &seen, &result};
+            mapping::traits<T>::visit(out, reader);
+        }
+
+        missing_checker checker{0, &seen, &result};
+        mapping::traits<T>::visit(out, checker);
+    }
+
+    static bool read(const document::element& e, double& out, decode_result&) {
+        if (e.type() != type::k_double) return false;
+        out = e.get_double().value;
+        return true;
+    }
+
+    static bool read(const document::element& e, bool& out, decode_result&) {
+        if (e.type() != type::k_bool) return false;
+        out = e.get_bool().value;
+        return true;
+    }
+
+    static bool read(const document::element& e, std::int32_t& out, decode_result&) {
+        if (e.type() != type::k_int32) return false;
+        out = e.get_int32().value;
+        return true;
+    }
+
+    /// int32 values are widened, as the server stores small integers as int32.
+    static bool read(const document::element& e, std::int64_t& out, decode_result&) {
+        switch (e.type()) {
+            case type::k_int64:
+                out = e.get_int64().value;
+                return true;
+            case type::k_int32:
+                out = e.get_int32().value;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static bool read(const document::element& e, std::string& out, decode_result&) {
+        if (e.type() != type::k_utf8) return false;
+        types::b_utf8 value = e.get_utf8();
+        out.assign(value.value.c_str(), value.value.length());
+        return true;
+    }
+
+    static bool read(const document::element& e, oid& out, decode_result&) {
+        if (e.type() != type::k_oid) return false;
+        out = e.get_oid().value;
+        return true;
+    }
+
+    static bool read(const document::element& e, types::b_date& out, decode_result&) {
+        if (e.type() != type::k_date) return false;
+        out = e.get_date();
+        return true;
+    }
+
+    static bool read(const document::element& e, types::b_timestamp& out, decode_result&) {
+        if (e.type() != type::k_timestamp) return false;
+        out = e.get_timestamp();
+        return true;
+    }
+
+    /// Points into the source document without copying.
+    static bool read(const document::element& e, document::view& out, decode_result&) {
+        if (e.type() != type::k_document) return false;
+        out = e.get_document().value;
+        return true;
+    }
+
+    template <typename T>
+    static typename std::enable_if<mapping::is_mapped<T>::value, bool>::type read(
+        const document::element& e, T& out, decode_result& result) {
+        if (e.type() != type::k_document) return false;
+        fields(e.get_document().value, out, result);
+        return true;
+    }
+
+    /// A null value disengages the optional.
+    template <typename T>
+    static bool read(const document::element& e, mongo::driver::optional<T>& out,
+                     decode_result& result) {
+        if (e.type() == type::k_null) {
+            out = mongo::driver::nullopt;
+            return true;
+        }
+
+        T value;
+
+        if (!read(e, value, result)) return false;
+
+        out = std::move(value);
+        return true;
+    }
+
+    template <typename T, typename Alloc>
+    static bool read(const document::element& e, std::vector<T, Alloc>& out,
+                     decode_result& result) {
+        if (e.type() != type::k_array) return false;
+
+        out.clear();
+
+        for (auto&& x : e.get_array().value) {
+            out.emplace_back();
+
+            if (!read(x, out.back(), result)) return false;
+        }
+
+        return true;
+    }
+
+    template <typename T, typename Compare, typename Alloc>
+    static bool read(const document::element& e, std::map<std::string, T, Compare, Alloc>& out,
+                     decode_result& result) {
+        if (e.type() != type::k_document) return false;
+
+        out.clear();
+
+        for (auto&& x : e.get_document().value) {
+            string_or_literal key = x.key();
+
+            if (!read(x, out[std::string{key.c_str(), key.length()}], result)) return false;
+        }
+
+        return true;
+    }
+
+   private:
+    /// Interns the keys of a mapped struct in declaration order, so field i gets id i.
+    template <typename T>
+    static key_table keys(const T& sample) {
+        key_table table;
+        key_collector collector{&table};
+        mapping::traits<T>::visit(sample, collector);
+        return table;
+    }
+
+    template <typename T>
+    struct is_optional : std::false_type {};
+
+    template <typename T>
+    struct is_optional<mongo::driver::optional<T>> : std::true_type {};
+
+    struct key_collector {
+        template <typename T>
+        bool operator()(const mapping::key& k, T&) {
+            table->intern(k.data, k.length);
+            return false;
+        }
+
+        key_table* table;
+    };
+
+    struct field_reader {
+        template <typename T>
+        bool operator()(const mapping::key& k, T& field) {
+            std::size_t i = index++;
+
+            if (i != id) {
+                return false;
+            }
+
+            seen->set(i);
+
+            if (!read(*e, field, *result)) {
+                result->add(k.data, decode_error_code::k_type_mismatch, e->type());
+            }
+
+            return true;
+        }
+
+        const document::element* e;
+        key_table::id_type id;
+        std::size_t index;
+        std::bitset<k_max_fields>* seen;
+        decode_result* result;
+    };
+
+    struct missing_checker {
+        template <typename T>
+        bool operator()(const mapping::key& k, T&) {
+            std::size_t i = index++;
+
+            if (!is_optional<T>::value && !seen->test(i)) {
+                result->add(k.data, decode_error_code::k_missing, type::k_eod);
+            }
+
+            return false;
+        }
+
+        std::size_t index;
+        std::bitset<k_max_fields>* seen;
+        decode_result* result;
+    };
+};
+
+/// Decodes a document into a mapped struct. Fields absent from the document keep their previous
+/// values.
+template <typename T>
+decode_result decode(const document::view& view, T& out) {
+    decode_result result;
+    decoder::fields(view, out, result);
+    return result;
+}
+
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
@@ -18,3 +18,5 @@
 #include "bson/document/view.hpp"
 #include "bson/document/value.hpp"
 #include "bson/document/view_or_value.hpp"
+#include "bson/document/editor.hpp"
+#include "bson/document/arena.hpp"
@@ -0,0 +1,92 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bson/document/arena.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace bson {
+namespace document {
+
+constexpr std::size_t arena::k_default_chunk_size;
+
+arena::arena(std::size_t chunk_size) : _chunk_size(chunk_size), _bytes(0) {}
+
+arena::arena(arena&& rhs) = default;
+arena& arena::operator=(arena&& rhs) = default;
+arena::~arena() = default;
+
+std::uint8_t* arena::allocate(std::size_t len) {
+    if (_chunks.empty() || _chunks.back().capacity - _chunks.back().used < len) {
+        std::size_t capacity = len > _chunk_size ? len : _chunk_size;
+
+        _chunks.push_back(chunk{std::unique_ptr<std::uint8_t[]>(new std::uint8_t[capacity]),
+                                capacity, 0});
+    }
+
+    chunk& c = _chunks.back();
+    std::uint8_t* out = c.data.get() + c.used;
+    c.used += len;
+
+    return out;
+}
+
+view arena::push_back(const view& doc) {
+    std::size_t len = doc.get_len();
+    std::uint8_t* copy = allocate(len);
+
+    std::memcpy(copy, doc.get_buf(), len);
+
+    _views.emplace_back(copy, len);
+    _bytes += len;
+
+    return _views.back();
+}
+
+const view& arena::operator[](std::size_t i) const { return _views[i]; }
+
+arena::const_iterator arena::begin() const { return _views.begin(); }
+
+arena::const_iterator arena::end() const { return _views.end(); }
+
+std::size_t arena::size() const { return _views.size(); }
+
+bool arena::empty() const { return _views.empty(); }
+
+std::size_t arena::bytes() const { return _bytes; }
+
+void arena::clear() {
+    if (_chunks.size() > 1) {
+        _chunks.erase(_chunks.begin() + 1, _chunks.end());
+    }
+
+    if (!_chunks.empty()) {
+        _chunks.front().used = 0;
+    }
+
+    _views.clear();
+    _bytes = 0;
+}
+
+std::shared_ptr<const arena> arena::share() {
+    std::shared_ptr<const arena> shared = std::make_shared<arena>(std::move(*this));
+
+    *this = arena{_chunk_size};
+
+    return shared;
+}
+
+}  // namespace document
+}  // namespace bson
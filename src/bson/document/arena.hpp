@@ -0,0 +1,90 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bson/document/view.hpp"
+
+namespace bson {
+namespace document {
+
+/// Keeps copies of many documents, such as a cursor's results, in a few large chunks instead of
+/// one allocation per document.
+///
+/// Documents are packed back to back in insertion order, so walking the arena reads memory
+/// sequentially. The views it hands out stay valid until the arena is cleared or destroyed, and
+/// all of its memory is released at once. Moving an arena does not invalidate its views.
+///
+///   document::arena results;
+///   for (auto&& doc : cursor) results.push_back(doc);
+class LIBMONGOCXX_EXPORT arena {
+   public:
+    using const_iterator = std::vector<view>::const_iterator;
+
+    static constexpr std::size_t k_default_chunk_size = 1 << 20;
+
+    /// Documents larger than chunk_size are given a chunk of their own.
+    explicit arena(std::size_t chunk_size = k_default_chunk_size);
+
+    arena(arena&& rhs);
+    arena& operator=(arena&& rhs);
+    ~arena();
+
+    /// Copies a document into the arena and returns a view of the copy.
+    view push_back(const view& doc);
+
+    const view& operator[](std::size_t i) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    std::size_t size() const;
+    bool empty() const;
+
+    /// The total size of the documents held.
+    std::size_t bytes() const;
+
+    /// Releases every document, keeping the first chunk for reuse.
+    void clear();
+
+    /// Moves the arena's contents into a reference counted handle, so that many owners can share
+    /// the whole batch. The arena is left empty.
+    std::shared_ptr<const arena> share();
+
+   private:
+    struct chunk {
+        std::unique_ptr<std::uint8_t[]> data;
+        std::size_t capacity;
+        std::size_t used;
+    };
+
+    std::uint8_t* allocate(std::size_t len);
+
+    std::size_t _chunk_size;
+    std::size_t _bytes;
+    std::vector<chunk> _chunks;
+    std::vector<view> _views;
+};
+
+}  // namespace document
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
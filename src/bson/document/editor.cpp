@@ -0,0 +1,233 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "bson/document/editor.hpp"
+#include "bson/util/endian.hpp"
+#include "bson/util/raw.hpp"
+
+namespace bson {
+namespace document {
+
+namespace {
+
+// Walks a dotted path from the root of doc. On success out is the target element with absolute
+// offsets, and parents holds the offsets of every enclosing document, the root included.
+bool locate(const std::uint8_t* doc, const string_or_literal& path, std::size_t* parents,
+            std::size_t* depth, util::raw::element* out) {
+    const char* segment = path.c_str();
+    const char* path_end = segment + path.length();
+    std::size_t base = 0;
+
+    *depth = 0;
+
+    for (;;) {
+        const char* dot = static_cast<const char*>(std::memchr(segment, '.', path_end - segment));
+        const char* segment_end = dot ? dot : path_end;
+
+        if (*depth == editor::k_max_depth) {
+            return false;
+        }
+
+        parents[(*depth)++] = base;
+
+        std::size_t len = static_cast<std::uint32_t>(util::load_int32(doc + base));
+
+        if (!util::raw::find(doc + base, len, segment, segment_end - segment, out)) {
+            return false;
+        }
+
+        out->offset += base;
+        out->value_offset += base;
+
+        if (!dot) {
+            return true;
+        }
+
+        if (out->type != type::k_document && out->type != type::k_array) {
+            return false;
+        }
+
+        base = out->value_offset;
+        segment = dot + 1;
+    }
+}
+
+}  // namespace
+
+constexpr std::size_t editor::k_max_depth;
+
+editor::editor(value& doc) : _doc(&doc) {}
+
+template <typename Fill>
+bool editor::replace(const string_or_literal& path, type t, std::size_t len, const void* source,
+                     Fill fill) {
+    std::size_t parents[k_max_depth];
+    std::size_t depth;
+    util::raw::element e;
+
+    std::uint8_t* buf = static_cast<std::uint8_t*>(_doc->_buf.get());
+
+    if (!locate(buf, path, parents, &depth, &e)) {
+        return false;
+    }
+
+    if (e.type == t && e.value_len == len) {
+        fill(buf + e.value_offset);
+        return true;
+    }
+
+    std::size_t tail = e.end();
+    std::size_t tail_len = _doc->_len - tail;
+    std::size_t new_len = _doc->_len - e.value_len + len;
+    std::int32_t delta = static_cast<std::int32_t>(len) - static_cast<std::int32_t>(e.value_len);
+
+    // New bytes read from this document would be overwritten by shifting the tail, so splice into
+    // a fresh buffer and keep the old one until they are copied.
+    std::uintptr_t from = reinterpret_cast<std::uintptr_t>(source);
+    std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(buf);
+    bool aliased = from >= begin && from < begin + _doc->_len;
+
+    std::unique_ptr<void, void (*)(void*)> old{nullptr, std::free};
+
+    if (!aliased && _doc->_buf.get_deleter() == static_cast<void (*)(void*)>(std::free)) {
+        // We own a malloc'd buffer, so the tail can be shifted where it is.
+        if (len < e.value_len) {
+            std::memmove(buf + e.value_offset + len, buf + tail, tail_len);
+        } else {
+            void* grown = std::realloc(buf, new_len);
+
+            if (!grown) {
+                throw std::bad_alloc();
+            }
+
+            _doc->_buf.release();
+            _doc->_buf.reset(grown);
+            buf = static_cast<std::uint8_t*>(grown);
+
+            std::memmove(buf + e.value_offset + len, buf + tail, tail_len);
+        }
+    } else {
+        std::uint8_t* copy = static_cast<std::uint8_t*>(std::malloc(new_len));
+
+        if (!copy) {
+            throw std::bad_alloc();
+        }
+
+        std::memcpy(copy, buf, e.value_offset);
+        std::memcpy(copy + e.value_offset + len, buf + tail, tail_len);
+
+        old = std::move(_doc->_buf);
+        _doc->_buf = std::unique_ptr<void, void (*)(void*)>(copy, std::free);
+        buf = copy;
+    }
+
+    buf[e.offset] = static_cast<std::uint8_t>(t);
+    fill(buf + e.value_offset);
+
+    for (std::size_t i = 0; i < depth; i++) {
+        util::store_int32(buf + parents[i], util::load_int32(buf + parents[i]) + delta);
+    }
+
+    _doc->_len = new_len;
+
+    return true;
+}
+
+bool editor::set(const string_or_literal& path, const types::b_double& v) {
+    return replace(path, type::k_double, 8, nullptr,
+                   [&](std::uint8_t* p) { util::store_double(p, v.value); });
+}
+
+bool editor::set(const string_or_literal& path, const types::b_bool& v) {
+    return replace(path, type::k_bool, 1, nullptr, [&](std::uint8_t* p) { *p = v.value ? 1 : 0; });
+}
+
+bool editor::set(const string_or_literal& path, const types::b_int32& v) {
+    return replace(path, type::k_int32, 4, nullptr,
+                   [&](std::uint8_t* p) { util::store_int32(p, v.value); });
+}
+
+bool editor::set(const string_or_literal& path, const types::b_int64& v) {
+    return replace(path, type::k_int64, 8, nullptr,
+                   [&](std::uint8_t* p) { util::store_int64(p, v.value); });
+}
+
+bool editor::set(const string_or_literal& path, const types::b_date& v) {
+    return replace(path, type::k_date, 8, nullptr,
+                   [&](std::uint8_t* p) { util::store_int64(p, v.value); });
+}
+
+bool editor::set(const string_or_literal& path, const types::b_timestamp& v) {
+    return replace(path, type::k_timestamp, 8, nullptr, [&](std::uint8_t* p) {
+        util::store_int32(p, static_cast<std::int32_t>(v.increment));
+        util::store_int32(p + 4, static_cast<std::int32_t>(v.timestamp));
+    });
+}
+
+bool editor::set(const string_or_literal& path, const types::b_oid& v) {
+    return replace(path, type::k_oid, 12, nullptr,
+                   [&](std::uint8_t* p) { std::memcpy(p, v.value.bytes(), 12); });
+}
+
+bool editor::set(const string_or_literal& path, const types::b_utf8& v) {
+    std::size_t len = v.value.length();
+
+    return replace(path, type::k_utf8, len + 5, v.value.c_str(), [&](std::uint8_t* p) {
+        util::store_int32(p, static_cast<std::int32_t>(len + 1));
+        std::memmove(p + 4, v.value.c_str(), len);
+        p[len + 4] = '\0';
+    });
+}
+
+bool editor::set(const string_or_literal& path, const types::b_document& v) {
+    return replace(path, type::k_document, v.value.get_len(), v.value.get_buf(),
+                   [&](std::uint8_t* p) { std::memmove(p, v.value.get_buf(), v.value.get_len()); });
+}
+
+bool editor::set(const string_or_literal& path, const types::b_array& v) {
+    return replace(path, type::k_array, v.value.get_len(), v.value.get_buf(),
+                   [&](std::uint8_t* p) { std::memmove(p, v.value.get_buf(), v.value.get_len()); });
+}
+
+bool editor::set(const string_or_literal& path, const types::b_binary& v) {
+    return replace(path, type::k_binary, v.size + 5, v.bytes, [&](std::uint8_t* p) {
+        util::store_int32(p, static_cast<std::int32_t>(v.size));
+        p[4] = static_cast<std::uint8_t>(v.sub_type);
+        std::memmove(p + 5, v.bytes, v.size);
+    });
+}
+
+bool editor::set(const string_or_literal& path, const types::b_null&) {
+    return replace(path, type::k_null, 0, nullptr, [](std::uint8_t*) {});
+}
+
+bool editor::set(const string_or_literal& path, const element& v) {
+    util::raw::element source;
+
+    if (!v._raw || !util::raw::read(v._raw, v._len, v._off, &source)) {
+        return false;
+    }
+
+    const std::uint8_t* bytes = v._raw + source.value_offset;
+
+    return replace(path, source.type, source.value_len, bytes,
+                   [&](std::uint8_t* p) { std::memmove(p, bytes, source.value_len); });
+}
+
+}  // namespace document
+}  // namespace bson
@@ -0,0 +1,75 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bson/document/element.hpp"
+#include "bson/document/value.hpp"
+#include "bson/string_or_literal.hpp"
+#include "bson/types.hpp"
+
+namespace bson {
+namespace document {
+
+/// Modifies the values of an existing document::value without rebuilding it.
+///
+/// Fields are addressed by key or by dotted path ("a.b.0.c"), and each set() returns false when
+/// the path does not exist. When the new value has the same type and encoded size as the old one
+/// (always the case for same-typed fixed-width values) its bytes are overwritten in place.
+/// Otherwise the element is spliced: the tail of the document is shifted and only the length
+/// prefixes of the enclosing documents are rewritten.
+///
+/// Views taken from the value before a splice may be invalidated, as the buffer can move.
+class LIBMONGOCXX_EXPORT editor {
+   public:
+    /// The deepest path the editor will follow, matching the server's nesting limit.
+    static constexpr std::size_t k_max_depth = 100;
+
+    explicit editor(value& doc);
+
+    bool set(const string_or_literal& path, const types::b_double& v);
+    bool set(const string_or_literal& path, const types::b_bool& v);
+    bool set(const string_or_literal& path, const types::b_int32& v);
+    bool set(const string_or_literal& path, const types::b_int64& v);
+    bool set(const string_or_literal& path, const types::b_date& v);
+    bool set(const string_or_literal& path, const types::b_timestamp& v);
+    bool set(const string_or_literal& path, const types::b_oid& v);
+
+    bool set(const string_or_literal& path, const types::b_utf8& v);
+    bool set(const string_or_literal& path, const types::b_document& v);
+    bool set(const string_or_literal& path, const types::b_array& v);
+    bool set(const string_or_literal& path, const types::b_binary& v);
+    bool set(const string_or_literal& path, const types::b_null& v);
+
+    /// Copies the type and value of an element from any document, including the one being edited.
+    bool set(const string_or_literal& path, const element& v);
+
+   private:
+    /// source is where fill reads the new value's bytes from, or nullptr if it reads none.
+    template <typename Fill>
+    bool replace(const string_or_literal& path, type t, std::size_t len, const void* source,
+                 Fill fill);
+
+    value* _doc;
+};
+
+}  // namespace document
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
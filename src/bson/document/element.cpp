@@ -54,16 +54,25 @@ bson::type element::type() const {
 }
 
 string_or_literal element::key() const {
+    const char* key = key_data();
+
+    return string_or_literal{key, std::strlen(key)};
+}
+
+const char* element::key_data() const {
     if (_raw == nullptr) {
-        return string_or_literal{""};
+        return "";
     }
 
-    CITER;
+    // The key directly follows the type byte, so there is no need to set up an iterator.
+    return reinterpret_cast<const char*>(_raw + _off + 1);
+}
 
-    const char* key = bson_iter_key(&iter);
+const std::uint8_t* element::raw() const { return _raw; }
 
-    return string_or_literal{key, std::strlen(key)};
-}
+std::uint32_t element::length() const { return _len; }
+
+std::uint32_t element::offset() const { return _off; }
 
 types::b_binary element::get_binary() const {
     CITER;
@@ -60,9 +60,11 @@ class concrete;
 namespace document {
 
 class view;
+class editor;
 
 class LIBMONGOCXX_EXPORT element {
     friend class document::view;
+    friend class document::editor;
     friend class builder::concrete;
 
    public:
@@ -75,6 +77,15 @@ class LIBMONGOCXX_EXPORT element {
 
     string_or_literal key() const;
 
+    /// The key as a NUL terminated string. Unlike key(), its length is not measured.
+    const char* key_data() const;
+
+    /// The bytes of the enclosing document, its length, and the offset of this element's type
+    /// byte within it. For code that copies elements without decoding them.
+    const std::uint8_t* raw() const;
+    std::uint32_t length() const;
+    std::uint32_t offset() const;
+
     types::b_eod get_eod() const;
     types::b_double get_double() const;
     types::b_utf8 get_utf8() const;
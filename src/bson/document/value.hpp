@@ -23,7 +23,11 @@
 namespace bson {
 namespace document {
 
+class editor;
+
 class LIBMONGOCXX_EXPORT value {
+    friend class editor;
+
    public:
     value(const std::uint8_t* b, std::size_t l, void (*dtor)(void*) = free);
     value(const view& view);
@@ -61,7 +61,10 @@ view::iterator view::begin() const {
 
     bson_init_static(&b, buf, len);
     bson_iter_init(&iter, &b);
-    bson_iter_next(&iter);
+
+    if (!bson_iter_next(&iter)) {
+        return end();
+    }
 
     return iterator(&iter);
 }
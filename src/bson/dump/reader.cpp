@@ -0,0 +1,180 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bson/dump/reader.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "bson/util/endian.hpp"
+
+namespace bson {
+namespace dump {
+
+namespace {
+
+const std::size_t kMinDocumentSize = 5;
+
+// Returns the length of the document starting at pos, throwing if it does not fit in what is
+// left of the file.
+std::size_t document_length(const std::uint8_t* pos, const std::uint8_t* end) {
+    std::size_t remaining = end - pos;
+
+    if (remaining < kMinDocumentSize) {
+        throw std::runtime_error("truncated document in bson dump");
+    }
+
+    std::int32_t len = util::load_int32(pos);
+
+    if (len < static_cast<std::int32_t>(kMinDocumentSize) ||
+        static_cast<std::size_t>(len) > remaining || pos[len - 1] != '\0') {
+        throw std::runtime_error("corrupt document length in bson dump");
+    }
+
+    return len;
+}
+
+}  // namespace
+
+reader::iterator::iterator(const std::uint8_t* pos, const std::uint8_t* end)
+    : _pos(pos), _end(end) {
+    load();
+}
+
+void reader::iterator::load() {
+    if (_pos != _end) {
+        _doc = document::view{_pos, document_length(_pos, _end)};
+    }
+}
+
+const document::view& reader::iterator::operator*() const { return _doc; }
+const document::view* reader::iterator::operator->() const { return &_doc; }
+
+reader::iterator& reader::iterator::operator++() {
+    _pos += _doc.get_len();
+    load();
+    return *this;
+}
+
+bool reader::iterator::operator==(const iterator& rhs) const { return _pos == rhs._pos; }
+bool reader::iterator::operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+reader::range::range(const std::uint8_t* begin, const std::uint8_t* end)
+    : _begin(begin), _end(end) {}
+
+reader::iterator reader::range::begin() const { return iterator(_begin, _end); }
+reader::iterator reader::range::end() const { return iterator(_end, _end); }
+std::size_t reader::range::size() const { return _end - _begin; }
+
+reader::reader(const std::string& path) : _data(nullptr), _len(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        throw std::runtime_error("unable to open " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat st;
+
+    if (::fstat(fd, &st) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error("unable to stat " + path + ": " + std::strerror(err));
+    }
+
+    _len = st.st_size;
+
+    if (_len > 0) {
+        void* data = ::mmap(nullptr, _len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data == MAP_FAILED) {
+            int err = errno;
+            ::close(fd);
+            throw std::runtime_error("unable to map " + path + ": " + std::strerror(err));
+        }
+
+        ::madvise(data, _len, MADV_SEQUENTIAL);
+        ::madvise(data, _len, MADV_WILLNEED);
+
+        _data = static_cast<const std::uint8_t*>(data);
+    }
+
+    // The mapping keeps the file alive on its own.
+    ::close(fd);
+}
+
+reader::reader(reader&& rhs) : _data(rhs._data), _len(rhs._len) {
+    rhs._data = nullptr;
+    rhs._len = 0;
+}
+
+reader& reader::operator=(reader&& rhs) {
+    unmap();
+
+    _data = rhs._data;
+    _len = rhs._len;
+
+    rhs._data = nullptr;
+    rhs._len = 0;
+
+    return *this;
+}
+
+reader::~reader() { unmap(); }
+
+void reader::unmap() {
+    if (_data) {
+        ::munmap(const_cast<std::uint8_t*>(_data), _len);
+    }
+}
+
+reader::iterator reader::begin() const { return iterator(_data, _data + _len); }
+reader::iterator reader::end() const { return iterator(_data + _len, _data + _len); }
+
+std::size_t reader::size() const { return _len; }
+
+std::vector<reader::range> reader::split(std::size_t n) const {
+    std::vector<range> ranges;
+
+    const std::uint8_t* end = _data + _len;
+    const std::uint8_t* start = _data;
+    const std::uint8_t* pos = _data;
+
+    for (std::size_t i = 1; i < n && pos != end; i++) {
+        const std::uint8_t* target = _data + (_len / n) * i;
+
+        while (pos < target && pos != end) {
+            pos += document_length(pos, end);
+        }
+
+        if (pos != start) {
+            ranges.emplace_back(range{start, pos});
+            start = pos;
+        }
+    }
+
+    if (start != end) {
+        ranges.emplace_back(range{start, end});
+    }
+
+    return ranges;
+}
+
+}  // namespace dump
+}  // namespace bson
@@ -0,0 +1,105 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "bson/document/view.hpp"
+
+namespace bson {
+namespace dump {
+
+/// Reads a mongodump style .bson file, a plain concatenation of documents, by mapping it into
+/// memory. The views handed out point straight into the mapping and stay valid for the lifetime
+/// of the reader.
+class LIBMONGOCXX_EXPORT reader {
+   public:
+    class iterator : public std::iterator<std::forward_iterator_tag, document::view,
+                                          std::ptrdiff_t, const document::view*,
+                                          const document::view&> {
+        friend class reader;
+
+       public:
+        const document::view& operator*() const;
+        const document::view* operator->() const;
+
+        iterator& operator++();
+
+        bool operator==(const iterator& rhs) const;
+        bool operator!=(const iterator& rhs) const;
+
+       private:
+        iterator(const std::uint8_t* pos, const std::uint8_t* end);
+
+        void load();
+
+        const std::uint8_t* _pos;
+        const std::uint8_t* _end;
+        document::view _doc;
+    };
+
+    /// A run of whole documents within the file.
+    class range {
+        friend class reader;
+
+       public:
+        iterator begin() const;
+        iterator end() const;
+
+        std::size_t size() const;
+
+       private:
+        range(const std::uint8_t* begin, const std::uint8_t* end);
+
+        const std::uint8_t* _begin;
+        const std::uint8_t* _end;
+    };
+
+    explicit reader(const std::string& path);
+
+    reader(reader&& rhs);
+    reader& operator=(reader&& rhs);
+    ~reader();
+
+    iterator begin() const;
+    iterator end() const;
+
+    /// Splits the file at document boundaries into at most n ranges of roughly equal byte size,
+    /// for handing to parallel consumers. Only the length prefixes are read to find the
+    /// boundaries.
+    std::vector<range> split(std::size_t n) const;
+
+    std::size_t size() const;
+
+   private:
+    reader(const reader&) = delete;
+    reader& operator=(const reader&) = delete;
+
+    void unmap();
+
+    const std::uint8_t* _data;
+    std::size_t _len;
+};
+
+}  // namespace dump
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
@@ -0,0 +1,125 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bson/dump/writer.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace bson {
+namespace dump {
+
+constexpr std::size_t writer::k_default_buffer_size;
+
+writer::writer(const std::string& path, std::size_t buffer_size)
+    : _fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)), _buf_size(buffer_size) {
+    if (_fd < 0) {
+        throw std::runtime_error("unable to open " + path + ": " + std::strerror(errno));
+    }
+
+    _buf.reserve(_buf_size);
+}
+
+writer::writer(writer&& rhs) : _fd(rhs._fd), _buf(std::move(rhs._buf)), _buf_size(rhs._buf_size) {
+    rhs._fd = -1;
+}
+
+writer& writer::operator=(writer&& rhs) {
+    try {
+        close();
+    } catch (...) {
+    }
+
+    _fd = rhs._fd;
+    _buf = std::move(rhs._buf);
+    _buf_size = rhs._buf_size;
+
+    rhs._fd = -1;
+
+    return *this;
+}
+
+writer::~writer() {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void writer::write(const document::view& view) {
+    if (_buf.size() + view.get_len() > _buf_size) {
+        flush();
+    }
+
+    if (view.get_len() > _buf_size) {
+        write_fully(view.get_buf(), view.get_len());
+    } else {
+        _buf.insert(_buf.end(), view.get_buf(), view.get_buf() + view.get_len());
+    }
+}
+
+void writer::flush() {
+    if (!_buf.empty()) {
+        write_fully(_buf.data(), _buf.size());
+        _buf.clear();
+    }
+}
+
+void writer::close() {
+    if (_fd < 0) {
+        return;
+    }
+
+    int fd = _fd;
+
+    try {
+        flush();
+    } catch (...) {
+        _fd = -1;
+        ::close(fd);
+        throw;
+    }
+
+    _fd = -1;
+
+    if (::close(fd) != 0) {
+        throw std::runtime_error(std::string("unable to close bson dump: ") +
+                                 std::strerror(errno));
+    }
+}
+
+void writer::write_fully(const std::uint8_t* data, std::size_t len) {
+    while (len > 0) {
+        ssize_t n = ::write(_fd, data, len);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            throw std::runtime_error(std::string("unable to write bson dump: ") +
+                                     std::strerror(errno));
+        }
+
+        data += n;
+        len -= n;
+    }
+}
+
+}  // namespace dump
+}  // namespace bson
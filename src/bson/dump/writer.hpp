@@ -0,0 +1,66 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bson/document/view.hpp"
+
+namespace bson {
+namespace dump {
+
+/// Writes documents to a mongodump style .bson file. Documents are gathered into a large buffer
+/// and written out sequentially; documents larger than the buffer bypass it.
+class LIBMONGOCXX_EXPORT writer {
+   public:
+    static constexpr std::size_t k_default_buffer_size = 1 << 20;
+
+    /// Creates or truncates the file at path.
+    explicit writer(const std::string& path, std::size_t buffer_size = k_default_buffer_size);
+
+    writer(writer&& rhs);
+    writer& operator=(writer&& rhs);
+
+    /// Flushes whatever is still buffered. Errors at this point are lost; call close() to see
+    /// them.
+    ~writer();
+
+    void write(const document::view& view);
+
+    void flush();
+
+    /// Flushes and closes the file.
+    void close();
+
+   private:
+    writer(const writer&) = delete;
+    writer& operator=(const writer&) = delete;
+
+    void write_fully(const std::uint8_t* data, std::size_t len);
+
+    int _fd;
+    std::vector<std::uint8_t> _buf;
+    std::size_t _buf_size;
+};
+
+}  // namespace dump
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
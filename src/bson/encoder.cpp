@@ -0,0 +1,98 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <new>
+
+#include "bson/encoder.hpp"
+
+namespace bson {
+
+namespace {
+const std::size_t kInitialCapacity = 256;
+}  // namespace
+
+encoder::encoder() : _buf(nullptr), _len(0), _capacity(0) {}
+
+encoder::encoder(encoder&& rhs) : _buf(rhs._buf), _len(rhs._len), _capacity(rhs._capacity) {
+    rhs._buf = nullptr;
+    rhs._len = 0;
+    rhs._capacity = 0;
+}
+
+encoder& encoder::operator=(encoder&& rhs) {
+    std::free(_buf);
+
+    _buf = rhs._buf;
+    _len = rhs._len;
+    _capacity = rhs._capacity;
+
+    rhs._buf = nullptr;
+    rhs._len = 0;
+    rhs._capacity = 0;
+
+    return *this;
+}
+
+encoder::~encoder() { std::free(_buf); }
+
+void encoder::begin() {
+    _len = 0;
+    open();
+}
+
+document::view encoder::finish() {
+    close(0);
+    return document::view{_buf, _len};
+}
+
+document::value encoder::extract() {
+    document::value value{_buf, _len};
+
+    _buf = nullptr;
+    _len = 0;
+    _capacity = 0;
+
+    return value;
+}
+
+std::size_t encoder::open() {
+    std::size_t offset = _len;
+    reserve(4);
+    return offset;
+}
+
+void encoder::close(std::size_t offset) {
+    *reserve(1) = '\0';
+    util::store_int32(_buf + offset, static_cast<std::int32_t>(_len - offset));
+}
+
+void encoder::grow(std::size_t min_capacity) {
+    std::size_t capacity = _capacity ? _capacity : kInitialCapacity;
+
+    while (capacity < min_capacity) {
+        capacity *= 2;
+    }
+
+    void* buf = std::realloc(_buf, capacity);
+
+    if (!buf) {
+        throw std::bad_alloc();
+    }
+
+    _buf = static_cast<std::uint8_t*>(buf);
+    _capacity = capacity;
+}
+
+}  // namespace bson
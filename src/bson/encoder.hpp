@@ -0,0 +1,260 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <type_traits>
+
+#include "bson/document.hpp"
+#include "bson/mapping.hpp"
+#include "bson/oid.hpp"
+#include "bson/string_or_literal.hpp"
+#include "bson/types.hpp"
+#include "bson/util/endian.hpp"
+#include "bson/util/itoa.hpp"
+#include "driver/util/is_iterable.hpp"
+#include "driver/util/optional.hpp"
+
+namespace bson {
+
+/// Writes BSON for mapped structs straight into a growable buffer.
+///
+/// Unlike builder::concrete there is no key stack or context tracking: every append writes the
+/// element header and value in place, and keys coming from a mapping have their length known at
+/// compile time. Nested documents and arrays are written by reserving their length prefix and
+/// patching it once the body is complete.
+class LIBMONGOCXX_EXPORT encoder {
+   public:
+    encoder();
+    encoder(encoder&& rhs);
+    encoder& operator=(encoder&& rhs);
+    ~encoder();
+
+    /// Starts a new root document, discarding anything previously written. Keeps the buffer.
+    void begin();
+
+    /// Terminates the root document and returns a view of it. The view is valid until the next
+    /// call to begin() or extract().
+    document::view finish();
+
+    /// Hands ownership of a finished document to the caller.
+    document::value extract();
+
+    std::size_t open();
+    void close(std::size_t offset);
+
+    void element(type t, const char* key, std::size_t len) {
+        std::uint8_t* p = reserve(len + 2);
+        p[0] = static_cast<std::uint8_t>(t);
+        std::memcpy(p + 1, key, len);
+        p[len + 1] = '\0';
+    }
+
+    void write(const void* bytes, std::size_t len) { std::memcpy(reserve(len), bytes, len); }
+    void write_int32(std::int32_t v) { util::store_int32(reserve(4), v); }
+    void write_int64(std::int64_t v) { util::store_int64(reserve(8), v); }
+    void write_double(double v) { util::store_double(reserve(8), v); }
+
+    void write_string(const char* str, std::size_t len) {
+        std::uint8_t* p = reserve(len + 5);
+        util::store_int32(p, static_cast<std::int32_t>(len + 1));
+        std::memcpy(p + 4, str, len);
+        p[len + 4] = '\0';
+    }
+
+    void append(const char* key, std::size_t len, double value) {
+        element(type::k_double, key, len);
+        write_double(value);
+    }
+
+    void append(const char* key, std::size_t len, bool value) {
+        element(type::k_bool, key, len);
+        *reserve(1) = value ? 1 : 0;
+    }
+
+    void append(const char* key, std::size_t len, std::int32_t value) {
+        element(type::k_int32, key, len);
+        write_int32(value);
+    }
+
+    void append(const char* key, std::size_t len, std::int64_t value) {
+        element(type::k_int64, key, len);
+        write_int64(value);
+    }
+
+    void append(const char* key, std::size_t len, const std::string& value) {
+        element(type::k_utf8, key, len);
+        write_string(value.data(), value.length());
+    }
+
+    void append(const char* key, std::size_t len, const string_or_literal& value) {
+        element(type::k_utf8, key, len);
+        write_string(value.c_str(), value.length());
+    }
+
+    void append(const char* key, std::size_t len, const oid& value) {
+        element(type::k_oid, key, len);
+        write(value.bytes(), 12);
+    }
+
+    void append(const char* key, std::size_t len, const types::b_date& value) {
+        element(type::k_date, key, len);
+        write_int64(value.value);
+    }
+
+    void append(const char* key, std::size_t len, const types::b_timestamp& value) {
+        element(type::k_timestamp, key, len);
+        write_int32(static_cast<std::int32_t>(value.increment));
+        write_int32(static_cast<std::int32_t>(value.timestamp));
+    }
+
+    void append(const char* key, std::size_t len, const types::b_binary& value) {
+        element(type::k_binary, key, len);
+        write_int32(static_cast<std::int32_t>(value.size));
+        *reserve(1) = static_cast<std::uint8_t>(value.sub_type);
+        write(value.bytes, value.size);
+    }
+
+    void append(const char* key, std::size_t len, const types::b_null&) {
+        element(type::k_null, key, len);
+    }
+
+    void append(const char* key, std::size_t len, const document::view& value) {
+        element(type::k_document, key, len);
+        write(value.get_buf(), value.get_len());
+    }
+
+    void append(const char* key, std::size_t len, const document::value& value) {
+        append(key, len, value.view());
+    }
+
+    void append(const char* key, std::size_t len, const types::b_array& value) {
+        element(type::k_array, key, len);
+        write(value.value.get_buf(), value.value.get_len());
+    }
+
+    /// A mapped struct becomes an embedded document.
+    template <typename T>
+    typename std::enable_if<mapping::is_mapped<T>::value>::type append(const char* key,
+                                                                       std::size_t len,
+                                                                       const T& value) {
+        element(type::k_document, key, len);
+        std::size_t offset = open();
+        fields(value);
+        close(offset);
+    }
+
+    /// Disengaged optionals are omitted entirely.
+    template <typename T>
+    void append(const char* key, std::size_t len, const mongo::driver::optional<T>& value) {
+        if (value) {
+            append(key, len, *value);
+        }
+    }
+
+    /// Maps keyed by strings become embedded documents.
+    template <typename T, typename Compare, typename Alloc>
+    void append(const char* key, std::size_t len,
+                const std::map<std::string, T, Compare, Alloc>& value) {
+        element(type::k_document, key, len);
+        std::size_t offset = open();
+
+        for (auto&& x : value) {
+            append(x.first.data(), x.first.length(), x.second);
+        }
+
+        close(offset);
+    }
+
+    /// Any other container becomes an array.
+    template <typename T>
+    typename std::enable_if<mongo::driver::util::is_iterable<T>::value &&
+                            !mapping::is_mapped<T>::value>::type
+        append(const char* key, std::size_t len, const T& value) {
+        element(type::k_array, key, len);
+        std::size_t offset = open();
+        std::uint32_t i = 0;
+
+        for (auto&& x : value) {
+            util::itoa index(i++);
+            append(index.c_str(), index.length(), x);
+        }
+
+        close(offset);
+    }
+
+    /// Writes every field of a mapped struct into the currently open document.
+    template <typename T>
+    void fields(const T& value) {
+        field_writer writer{this};
+        mapping::traits<T>::visit(value, writer);
+    }
+
+   private:
+    struct field_writer {
+        template <typename T>
+        bool operator()(const mapping::key& k, const T& value) {
+            e->append(k.data, k.length, value);
+            return false;
+        }
+
+        encoder* e;
+    };
+
+    std::uint8_t* reserve(std::size_t n) {
+        if (_len + n > _capacity) {
+            grow(_len + n);
+        }
+
+        std::uint8_t* p = _buf + _len;
+        _len += n;
+        return p;
+    }
+
+    void grow(std::size_t min_capacity);
+
+    std::uint8_t* _buf;
+    std::size_t _len;
+    std::size_t _capacity;
+};
+
+/// Encodes a mapped struct into a new document.
+template <typename T>
+document::value encode(const T& value) {
+    encoder e;
+    e.begin();
+    e.fields(value);
+    e.finish();
+    return e.extract();
+}
+
+/// Encodes a mapped struct into the buffer of an existing encoder, so that encoding many values in
+/// a loop does not allocate once the buffer has grown large enough.
+template <typename T>
+document::view encode(const T& value, encoder& e) {
+    e.begin();
+    e.fields(value);
+    return e.finish();
+}
+
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
@@ -18,4 +18,5 @@ MONGOCXX_ENUM(binary_deprecated, 0x02)
 MONGOCXX_ENUM(uuid_deprecated, 0x03)
 MONGOCXX_ENUM(uuid, 0x04)
 MONGOCXX_ENUM(md5, 0x05)
+MONGOCXX_ENUM(vector, 0x09)
 MONGOCXX_ENUM(user, 0x80)
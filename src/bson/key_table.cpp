@@ -0,0 +1,131 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bson/key_table.hpp"
+
+#include <cstring>
+
+namespace bson {
+
+namespace {
+
+// FNV-1a over the bytes of a key.
+std::uint32_t hash_key(const char* str, std::size_t len) {
+    std::uint32_t h = 2166136261u;
+
+    for (std::size_t i = 0; i < len; i++) {
+        h = (h ^ static_cast<std::uint8_t>(str[i])) * 16777619u;
+    }
+
+    return h;
+}
+
+}  // namespace
+
+constexpr key_table::id_type key_table::k_npos;
+
+key_table::order::order(const key_table* table) : _table(table) {}
+
+key_table::id_type key_table::order::find(std::size_t position, const char* key) {
+    if (position < _ids.size()) {
+        id_type predicted = _ids[position];
+
+        if (predicted != k_npos && _table->matches(predicted, key)) {
+            return predicted;
+        }
+    } else {
+        _ids.resize(position + 1, k_npos);
+    }
+
+    return _ids[position] = _table->find(key, std::strlen(key));
+}
+
+key_table::key_table() : _slots(16, k_npos) {}
+
+key_table::id_type key_table::find(const char* key, std::size_t len, std::uint32_t hash,
+                                   std::size_t* slot) const {
+    std::size_t mask = _slots.size() - 1;
+
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+        id_type id = _slots[i];
+
+        if (id == k_npos) {
+            *slot = i;
+            return k_npos;
+        }
+
+        const entry& e = _entries[id];
+
+        if (e.hash == hash && e.key.length() == len && std::memcmp(e.key.data(), key, len) == 0) {
+            *slot = i;
+            return id;
+        }
+    }
+}
+
+key_table::id_type key_table::intern(const char* key, std::size_t len) {
+    std::uint32_t hash = hash_key(key, len);
+    std::size_t slot;
+    id_type id = find(key, len, hash, &slot);
+
+    if (id != k_npos) {
+        return id;
+    }
+
+    id = static_cast<id_type>(_entries.size());
+    _entries.push_back(entry{std::string{key, len}, hash});
+    _slots[slot] = id;
+
+    if (_entries.size() * 2 > _slots.size()) {
+        grow();
+    }
+
+    return id;
+}
+
+key_table::id_type key_table::find(const char* key, std::size_t len) const {
+    std::size_t slot;
+    return find(key, len, hash_key(key, len), &slot);
+}
+
+bool key_table::matches(id_type id, const char* key) const {
+    const std::string& expected = _entries[id].key;
+
+    // strncmp stops at the end of a shorter key, so this never reads past it.
+    return std::strncmp(key, expected.data(), expected.length()) == 0 &&
+           key[expected.length()] == '\0';
+}
+
+const std::string& key_table::key(id_type id) const { return _entries[id].key; }
+
+std::size_t key_table::size() const { return _entries.size(); }
+
+void key_table::grow() {
+    std::vector<id_type> slots(_slots.size() * 2, k_npos);
+    std::size_t mask = slots.size() - 1;
+
+    for (id_type id = 0; id < _entries.size(); id++) {
+        std::size_t i = _entries[id].hash & mask;
+
+        while (slots[i] != k_npos) {
+            i = (i + 1) & mask;
+        }
+
+        slots[i] = id;
+    }
+
+    _slots.swap(slots);
+}
+
+}  // namespace bson
@@ -0,0 +1,86 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bson {
+
+/// Interns document keys, mapping each distinct key to a small integer id. Ids are handed out
+/// densely from zero in the order keys are first interned, so they can index plain arrays.
+///
+/// A table is not synchronized: intern() must not race with anything, while find() and the
+/// other const members may be called from many threads at once.
+class LIBMONGOCXX_EXPORT key_table {
+   public:
+    using id_type = std::uint32_t;
+
+    static constexpr id_type k_npos = 0xffffffff;
+
+    /// Predicts the keys of documents that share a layout. Remembers the id seen at each
+    /// position of the last document, so that when the next document has the same key in the
+    /// same place it is recognized with a single string compare, without measuring or hashing
+    /// it. Keep one per thread.
+    class order {
+       public:
+        explicit order(const key_table* table);
+
+        /// Returns the id of the NUL terminated key found at the given position of a document,
+        /// or k_npos if the table does not hold it.
+        id_type find(std::size_t position, const char* key);
+
+       private:
+        const key_table* _table;
+        std::vector<id_type> _ids;
+    };
+
+    key_table();
+
+    /// Returns the id of the key, adding it if it is new.
+    id_type intern(const char* key, std::size_t len);
+
+    /// Returns the id of the key, or k_npos.
+    id_type find(const char* key, std::size_t len) const;
+
+    /// Whether the NUL terminated key is the one with the given id.
+    bool matches(id_type id, const char* key) const;
+
+    const std::string& key(id_type id) const;
+
+    std::size_t size() const;
+
+   private:
+    struct entry {
+        std::string key;
+        std::uint32_t hash;
+    };
+
+    id_type find(const char* key, std::size_t len, std::uint32_t hash, std::size_t* slot) const;
+
+    void grow();
+
+    std::vector<entry> _entries;
+    // Open addressing over ids, with a power of two size kept at most half full.
+    std::vector<id_type> _slots;
+};
+
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
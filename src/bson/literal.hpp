@@ -0,0 +1,179 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bson/document/view.hpp"
+#include "bson/types.hpp"
+
+namespace bson {
+
+/// Documents encoded entirely at compile time, for constant queries, projections, sorts and
+/// options that would otherwise be rebuilt with a builder on every call:
+///
+///   static constexpr auto by_id = literal::doc(literal::field("_id", 1));
+///   collection.find(model::find{}.sort(by_id.view()));
+///
+/// The encoded bytes are a constant array, so view() costs nothing at runtime. Values may be
+/// int32, int64, bool, strings, null and nested documents. Doubles are not supported, as their
+/// bit patterns cannot be computed in a C++11 constant expression.
+namespace literal {
+
+template <std::size_t n>
+struct bytes {
+    std::uint8_t data[n];
+};
+
+template <std::size_t n>
+class encoded_document {
+   public:
+    constexpr encoded_document(const bytes<n>& encoded) : _encoded(encoded) {}
+
+    constexpr const bytes<n>& encoded() const { return _encoded; }
+
+    document::view view() const { return document::view{_encoded.data, n}; }
+    operator document::view() const { return view(); }
+
+   private:
+    bytes<n> _encoded;
+};
+
+struct null_t {};
+constexpr null_t null{};
+
+namespace detail {
+
+template <std::size_t... i>
+struct indices {};
+
+template <std::size_t n, std::size_t... i>
+struct make_indices : make_indices<n - 1, n - 1, i...> {};
+
+template <std::size_t... i>
+struct make_indices<0, i...> {
+    using type = indices<i...>;
+};
+
+template <std::size_t... n>
+struct sum;
+
+template <>
+struct sum<> {
+    static constexpr std::size_t value = 0;
+};
+
+template <std::size_t n, std::size_t... rest>
+struct sum<n, rest...> {
+    static constexpr std::size_t value = n + sum<rest...>::value;
+};
+
+template <std::size_t n, std::size_t m, std::size_t... i, std::size_t... j>
+constexpr bytes<n + m> concat(const bytes<n>& a, const bytes<m>& b, indices<i...>, indices<j...>) {
+    return bytes<n + m>{{a.data[i]..., b.data[j]...}};
+}
+
+template <std::size_t n, std::size_t m>
+constexpr bytes<n + m> cat(const bytes<n>& a, const bytes<m>& b) {
+    return concat(a, b, typename make_indices<n>::type{}, typename make_indices<m>::type{});
+}
+
+template <std::size_t n>
+constexpr bytes<n> join(const bytes<n>& a) {
+    return a;
+}
+
+template <std::size_t n, std::size_t m, std::size_t... rest>
+constexpr bytes<sum<n, m, rest...>::value> join(const bytes<n>& a, const bytes<m>& b,
+                                                 const bytes<rest>&... tail) {
+    return join(cat(a, b), tail...);
+}
+
+constexpr bytes<1> byte(std::uint8_t b) { return bytes<1>{{b}}; }
+
+constexpr bytes<4> le32(std::uint32_t v) {
+    return bytes<4>{{static_cast<std::uint8_t>(v), static_cast<std::uint8_t>(v >> 8),
+                     static_cast<std::uint8_t>(v >> 16), static_cast<std::uint8_t>(v >> 24)}};
+}
+
+constexpr bytes<8> le64(std::uint64_t v) {
+    return cat(le32(static_cast<std::uint32_t>(v)), le32(static_cast<std::uint32_t>(v >> 32)));
+}
+
+/// The characters of a string literal, NUL included.
+template <std::size_t n, std::size_t... i>
+constexpr bytes<n> cstring(const char (&str)[n], indices<i...>) {
+    return bytes<n>{{static_cast<std::uint8_t>(str[i])..., 0}};
+}
+
+template <std::size_t n>
+constexpr bytes<n> cstring(const char (&str)[n]) {
+    return cstring(str, typename make_indices<n - 1>::type{});
+}
+
+template <std::size_t k>
+constexpr bytes<1 + k> header(type t, const char (&key)[k]) {
+    return cat(byte(static_cast<std::uint8_t>(t)), cstring(key));
+}
+
+}  // namespace detail
+
+template <std::size_t k>
+constexpr bytes<k + 5> field(const char (&key)[k], std::int32_t v) {
+    return detail::cat(detail::header(type::k_int32, key),
+                       detail::le32(static_cast<std::uint32_t>(v)));
+}
+
+template <std::size_t k>
+constexpr bytes<k + 9> field(const char (&key)[k], std::int64_t v) {
+    return detail::cat(detail::header(type::k_int64, key),
+                       detail::le64(static_cast<std::uint64_t>(v)));
+}
+
+template <std::size_t k>
+constexpr bytes<k + 2> field(const char (&key)[k], bool v) {
+    return detail::cat(detail::header(type::k_bool, key), detail::byte(v ? 1 : 0));
+}
+
+template <std::size_t k, std::size_t n>
+constexpr bytes<k + n + 5> field(const char (&key)[k], const char (&v)[n]) {
+    return detail::join(detail::header(type::k_utf8, key), detail::le32(n), detail::cstring(v));
+}
+
+template <std::size_t k>
+constexpr bytes<k + 1> field(const char (&key)[k], null_t) {
+    return detail::header(type::k_null, key);
+}
+
+template <std::size_t k, std::size_t n>
+constexpr bytes<k + n + 1> field(const char (&key)[k], const encoded_document<n>& v) {
+    return detail::cat(detail::header(type::k_document, key), v.encoded());
+}
+
+constexpr encoded_document<5> doc() { return encoded_document<5>{bytes<5>{{5, 0, 0, 0, 0}}}; }
+
+template <std::size_t... n>
+constexpr encoded_document<detail::sum<n...>::value + 5> doc(const bytes<n>&... fields) {
+    return encoded_document<detail::sum<n...>::value + 5>{
+        detail::join(detail::le32(detail::sum<n...>::value + 5), fields..., detail::byte(0))};
+}
+
+}  // namespace literal
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
@@ -0,0 +1,91 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace bson {
+namespace mapping {
+
+/// The key of a mapped field, built from a string literal.
+struct key {
+    template <std::size_t n>
+    constexpr key(const char (&str)[n]) : data(str), length(n - 1) {}
+
+    const char* data;
+    std::size_t length;
+};
+
+/// Describes the fields of a struct for the BSON encoder and decoder. Specializations are normally
+/// generated with the MONGOCXX_BSON_MAPPING_* macros below, and provide:
+///
+///   template <typename Self, typename Visitor>
+///   static bool visit(Self& self, Visitor& visitor);
+///   static constexpr std::size_t field_count;
+///
+/// where visit calls visitor(key, self.member) for every field, in declaration order, and stops as
+/// soon as the visitor returns true.
+template <typename T>
+struct traits {
+    static constexpr bool is_mapped = false;
+};
+
+template <typename T>
+struct is_mapped : std::integral_constant<bool, traits<T>::is_mapped> {};
+
+}  // namespace mapping
+}  // namespace bson
+
+/// Declares the BSON mapping of a struct. Must be used at global scope:
+///
+///   MONGOCXX_BSON_MAPPING_BEGIN(point)
+///       MONGOCXX_BSON_FIELD(x)
+///       MONGOCXX_BSON_FIELD_NAMED(y, "_y")
+///   MONGOCXX_BSON_MAPPING_END()
+///
+/// Each field takes one __COUNTER__ value, which is how field_count is known at compile time.
+#define MONGOCXX_BSON_MAPPING_BEGIN(type)                       \
+    namespace bson {                                            \
+    namespace mapping {                                         \
+    template <>                                                 \
+    struct traits<type> {                                       \
+        static constexpr bool is_mapped = true;                 \
+        static constexpr std::size_t first_field = __COUNTER__; \
+                                                                \
+        template <typename Self, typename Visitor>              \
+        static bool visit(Self& self, Visitor& visitor) {
+
+#define MONGOCXX_BSON_FIELD_NAMED(member, name)        \
+    {                                                  \
+        static constexpr ::bson::mapping::key k{name}; \
+        (void)__COUNTER__;                             \
+        if (visitor(k, self.member)) return true;      \
+    }
+
+#define MONGOCXX_BSON_FIELD(member) MONGOCXX_BSON_FIELD_NAMED(member, #member)
+
+#define MONGOCXX_BSON_MAPPING_END()                                           \
+    return false;                                                             \
+    }                                                                         \
+    static constexpr std::size_t field_count = __COUNTER__ - first_field - 1; \
+    }                                                                         \
+    ;                                                                         \
+    }                                                                         \
+    }
+
+#include "driver/config/postlude.hpp"
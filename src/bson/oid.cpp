@@ -14,52 +14,182 @@
 
 #include "bson/oid.hpp"
 
+#include <pthread.h>
+#include <sys/time.h>
+
+#include <atomic>
 #include <cstring>
+#include <random>
 
 #include "bson/string_or_literal.hpp"
-#include "bson.h"
 
 namespace bson {
 
-oid::oid() : _is_valid(false) {}
+namespace {
+
+// Bumped in the child after a fork, so that every thread's generator notices and reseeds rather
+// than handing out the same oids as the parent.
+std::atomic<unsigned> fork_generation{0};
+
+void on_fork_child() { fork_generation.fetch_add(1, std::memory_order_relaxed); }
+
+struct generator_state {
+    generator_state() : generation(~0u) {
+        static const int registered = pthread_atfork(nullptr, nullptr, on_fork_child);
+        (void)registered;
+    }
+
+    void reseed() {
+        std::random_device device;
+        std::uint64_t seed = (static_cast<std::uint64_t>(device()) << 32) ^ device();
 
-oid::oid(init_tag_t) : _is_valid(true) {
-    bson_oid_t oid;
-    bson_oid_init(&oid, nullptr);
+        std::memcpy(process, &seed, sizeof(process));
+        counter = static_cast<std::uint32_t>(seed >> 40) ^ device();
+        generation = fork_generation.load(std::memory_order_relaxed);
+    }
+
+    unsigned generation;
+    std::uint8_t process[5];
+    std::uint32_t counter;
+};
 
-    std::memcpy(_bytes, oid.bytes, sizeof(oid.bytes));
+generator_state& thread_generator() {
+    static thread_local generator_state state;
+
+    if (state.generation != fork_generation.load(std::memory_order_relaxed)) {
+        state.reseed();
+    }
+
+    return state;
 }
 
-oid::oid(const string_or_literal& sol) : _is_valid(bson_oid_is_valid(sol.c_str(), sol.length())) {
-    if (_is_valid) {
-        bson_oid_t oid;
-        bson_oid_init_from_string(&oid, sol.c_str());
+void store_be32(char* out, std::uint32_t v) {
+    out[0] = static_cast<char>(v >> 24);
+    out[1] = static_cast<char>(v >> 16);
+    out[2] = static_cast<char>(v >> 8);
+    out[3] = static_cast<char>(v);
+}
+
+// Every byte value mapped to its two lowercase hex digits, so formatting is one table load and
+// one two byte store per input byte.
+struct hex_table {
+    hex_table() {
+        static const char digits[] = "0123456789abcdef";
+
+        for (int i = 0; i < 256; i++) {
+            pairs[i][0] = digits[i >> 4];
+            pairs[i][1] = digits[i & 0xf];
+        }
+
+        std::memset(values, 0xff, sizeof(values));
+
+        for (int i = 0; i < 10; i++) {
+            values['0' + i] = static_cast<std::uint8_t>(i);
+        }
+
+        for (int i = 0; i < 6; i++) {
+            values['a' + i] = static_cast<std::uint8_t>(10 + i);
+            values['A' + i] = static_cast<std::uint8_t>(10 + i);
+        }
+    }
+
+    char pairs[256][2];
+    // The value of each hex digit, or 0xff for any other character.
+    std::uint8_t values[256];
+};
+
+const hex_table& hex() {
+    static const hex_table table;
+    return table;
+}
+
+}  // namespace
+
+constexpr std::size_t oid::k_size;
+constexpr std::size_t oid::k_hex_length;
+
+oid::oid() : _is_valid(false) {}
+
+oid::oid(init_tag_t) { generate(this, 1); }
+
+oid::oid(const string_or_literal& sol) : _is_valid(false) {
+    if (sol.length() != k_hex_length) {
+        return;
+    }
+
+    const std::uint8_t* str = reinterpret_cast<const std::uint8_t*>(sol.c_str());
+    const std::uint8_t* values = hex().values;
+    std::uint8_t invalid = 0;
+
+    for (std::size_t i = 0; i < k_size; i++) {
+        std::uint8_t high = values[str[2 * i]];
+        std::uint8_t low = values[str[2 * i + 1]];
+
+        invalid |= (high | low) & 0xf0;
+        _bytes[i] = static_cast<char>((high << 4) | (low & 0xf));
     }
+
+    _is_valid = invalid == 0;
 }
 
-oid::oid(const char* bytes, std::size_t len) : _is_valid(len == 12) {
+oid::oid(const char* bytes, std::size_t len) : _is_valid(len == k_size) {
     if (_is_valid) {
         std::memcpy(_bytes, bytes, sizeof(_bytes));
     }
 }
 
-string_or_literal oid::to_string() const {
-    bson_oid_t oid;
-    std::memcpy(oid.bytes, _bytes, sizeof(oid.bytes));
-    char str[25];
+void oid::generate(oid* out, std::size_t n) {
+    if (n == 0) {
+        return;
+    }
+
+    generator_state& state = thread_generator();
+
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+
+    char prefix[9];
+    store_be32(prefix, static_cast<std::uint32_t>(now.tv_sec));
+    std::memcpy(prefix + 4, state.process, sizeof(state.process));
 
-    bson_oid_to_string(&oid, str);
+    std::uint32_t counter = state.counter;
+    state.counter += static_cast<std::uint32_t>(n);
 
-    return string_or_literal(str);
+    for (std::size_t i = 0; i < n; i++, counter++) {
+        char* bytes = out[i]._bytes;
+
+        std::memcpy(bytes, prefix, sizeof(prefix));
+        bytes[9] = static_cast<char>(counter >> 16);
+        bytes[10] = static_cast<char>(counter >> 8);
+        bytes[11] = static_cast<char>(counter);
+
+        out[i]._is_valid = true;
+    }
+}
+
+void oid::to_hex(char (&out)[k_hex_length]) const {
+    const hex_table& table = hex();
+
+    for (std::size_t i = 0; i < k_size; i++) {
+        std::memcpy(out + 2 * i, table.pairs[static_cast<std::uint8_t>(_bytes[i])], 2);
+    }
+}
+
+string_or_literal oid::to_string() const {
+    char str[k_hex_length];
+    to_hex(str);
+
+    return string_or_literal(std::string(str, sizeof(str)));
 }
 
 oid::operator bool() const { return _is_valid; }
 
 std::time_t oid::get_time_t() const {
-    bson_oid_t oid;
-    std::memcpy(oid.bytes, _bytes, sizeof(oid.bytes));
+    const std::uint8_t* b = reinterpret_cast<const std::uint8_t*>(_bytes);
 
-    return bson_oid_get_time_t(&oid);
+    return static_cast<std::time_t>((static_cast<std::uint32_t>(b[0]) << 24) |
+                                    (static_cast<std::uint32_t>(b[1]) << 16) |
+                                    (static_cast<std::uint32_t>(b[2]) << 8) | b[3]);
 }
 
 const char* oid::bytes() const { return _bytes; }
@@ -75,13 +205,7 @@ int oid_compare(const oid& lhs, const oid& rhs) {
         }
     }
 
-    bson_oid_t lhs_oid;
-    bson_oid_t rhs_oid;
-
-    std::memcpy(lhs_oid.bytes, lhs.bytes(), sizeof(lhs_oid.bytes));
-    std::memcpy(rhs_oid.bytes, rhs.bytes(), sizeof(rhs_oid.bytes));
-
-    return bson_oid_compare(&lhs_oid, &rhs_oid);
+    return std::memcmp(lhs._bytes, rhs._bytes, sizeof(lhs._bytes));
 }
 
 bool operator<(const oid& lhs, const oid& rhs) { return oid_compare(lhs, rhs) < 0; }
@@ -97,13 +221,10 @@ bool operator==(const oid& lhs, const oid& rhs) { return oid_compare(lhs, rhs) =
 bool operator!=(const oid& lhs, const oid& rhs) { return oid_compare(lhs, rhs) != 0; }
 
 std::ostream& operator<<(std::ostream& out, const oid& rhs) {
-    bson_oid_t oid;
-    std::memcpy(oid.bytes, rhs._bytes, sizeof(oid.bytes));
-    char str[25];
-
-    bson_oid_to_string(&oid, str);
+    char str[oid::k_hex_length];
+    rhs.to_hex(str);
 
-    out << str;
+    out.write(str, sizeof(str));
 
     return out;
 }
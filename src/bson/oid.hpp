@@ -16,8 +16,12 @@
 
 #include "driver/config/prelude.hpp"
 
-#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <ctime>
+#include <functional>
+#include <iostream>
 
 namespace bson {
 
@@ -28,14 +32,30 @@ class oid {
     struct init_tag_t {};
     static constexpr init_tag_t init_tag{};
 
+    static constexpr std::size_t k_size = 12;
+    static constexpr std::size_t k_hex_length = 24;
+
     oid();
 
+    /// Generates a new oid from the calling thread's generator. See generate().
     explicit oid(init_tag_t tag);
     explicit oid(const char* bytes, std::size_t len);
+    /// Parses 24 hex digits. The result is invalid if the string is not a well formed oid.
     explicit oid(const string_or_literal& sol);
 
+    /// Fills out with n new oids.
+    ///
+    /// Each thread keeps its own generator, with its own random process field and counter, so
+    /// generation takes no locks and shares no cache lines between threads. A batch reads the
+    /// clock once and reserves n counter values at a time. The generators are reseeded in the
+    /// child after a fork.
+    static void generate(oid* out, std::size_t n);
+
     string_or_literal to_string() const;
 
+    /// Writes the 24 hex digits of the oid into out, without a terminating NUL.
+    void to_hex(char (&out)[k_hex_length]) const;
+
     friend bool operator<(const oid& lhs, const oid& rhs);
     friend bool operator>(const oid& lhs, const oid& rhs);
     friend bool operator<=(const oid& lhs, const oid& rhs);
@@ -51,6 +71,22 @@ class oid {
 
     const char* bytes() const;
 
+    /// A hash of the oid's bytes, as used by std::hash<bson::oid>.
+    std::size_t hash() const {
+        if (!_is_valid) {
+            return 0;
+        }
+
+        // The timestamp and counter vary the most, so both 8 byte halves are mixed in.
+        std::uint64_t head;
+        std::uint64_t tail;
+        std::memcpy(&head, _bytes, sizeof(head));
+        std::memcpy(&tail, _bytes + 4, sizeof(tail));
+
+        std::uint64_t h = (head ^ (tail * 0x9E3779B97F4A7C15ull)) * 0xC2B2AE3D27D4EB4Full;
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+
    private:
     friend int oid_compare(const oid& lhs, const oid& rhs);
 
@@ -60,4 +96,13 @@ class oid {
 
 }  // namespace bson
 
+namespace std {
+
+template <>
+struct hash<bson::oid> {
+    std::size_t operator()(const bson::oid& oid) const { return oid.hash(); }
+};
+
+}  // namespace std
+
 #include "driver/config/postlude.hpp"
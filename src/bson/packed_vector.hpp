@@ -0,0 +1,223 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "bson/types.hpp"
+#include "bson/util/endian.hpp"
+#include "driver/util/optional.hpp"
+
+namespace bson {
+
+/// The element type of a packed vector, stored in its first byte.
+///
+/// Packed vectors use the layout of the BSON binary vector subtype: a dtype byte, a padding byte
+/// and then the little endian values. int8 and float32 are stored under the vector subtype with
+/// their published dtype codes. int16 and float64 have no published code, so they are stored under
+/// the user-defined subtype, where other tools will not mistake them for standard vectors.
+enum class packed_dtype : std::uint8_t {
+    k_int8 = 0x03,
+    k_int16 = 0x05,
+    k_float32 = 0x27,
+    k_float64 = 0x28,
+};
+
+template <typename T>
+struct packed_traits;
+
+template <>
+struct packed_traits<std::int8_t> {
+    static constexpr binary_sub_type sub_type = binary_sub_type::k_vector;
+    static constexpr packed_dtype dtype = packed_dtype::k_int8;
+};
+
+template <>
+struct packed_traits<std::int16_t> {
+    static constexpr binary_sub_type sub_type = binary_sub_type::k_user;
+    static constexpr packed_dtype dtype = packed_dtype::k_int16;
+};
+
+template <>
+struct packed_traits<float> {
+    static_assert(std::numeric_limits<float>::is_iec559, "packed floats must be IEEE 754");
+    static constexpr binary_sub_type sub_type = binary_sub_type::k_vector;
+    static constexpr packed_dtype dtype = packed_dtype::k_float32;
+};
+
+template <>
+struct packed_traits<double> {
+    static_assert(std::numeric_limits<double>::is_iec559, "packed doubles must be IEEE 754");
+    static constexpr binary_sub_type sub_type = binary_sub_type::k_user;
+    static constexpr packed_dtype dtype = packed_dtype::k_float64;
+};
+
+namespace packed_detail {
+
+constexpr std::size_t k_header_size = 2;
+
+template <std::size_t size>
+struct bits;
+
+template <>
+struct bits<1> {
+    using type = std::uint8_t;
+    static type to_le(type v) { return v; }
+};
+
+template <>
+struct bits<2> {
+    using type = std::uint16_t;
+    static type to_le(type v) { return util::to_le(v); }
+};
+
+template <>
+struct bits<4> {
+    using type = std::uint32_t;
+    static type to_le(type v) { return util::to_le(v); }
+};
+
+template <>
+struct bits<8> {
+    using type = std::uint64_t;
+    static type to_le(type v) { return util::to_le(v); }
+};
+
+template <typename T>
+T load(const std::uint8_t* p) {
+    using b = bits<sizeof(T)>;
+
+    typename b::type raw;
+    std::memcpy(&raw, p, sizeof(raw));
+    raw = b::to_le(raw);
+
+    T value;
+    std::memcpy(&value, &raw, sizeof(value));
+    return value;
+}
+
+template <typename T>
+void store(std::uint8_t* p, T value) {
+    using b = bits<sizeof(T)>;
+
+    typename b::type raw;
+    std::memcpy(&raw, &value, sizeof(raw));
+    raw = b::to_le(raw);
+    std::memcpy(p, &raw, sizeof(raw));
+}
+
+}  // namespace packed_detail
+
+/// Owns the encoding of a vector of numbers as one binary value, which costs sizeof(T) bytes per
+/// value instead of the key, type byte and value of every element of an array.
+///
+///   builder << "embedding" << packed_vector::pack(values).binary();
+class packed_vector {
+   public:
+    template <typename T>
+    static packed_vector pack(const T* values, std::size_t n) {
+        packed_vector out;
+
+        out._sub_type = packed_traits<T>::sub_type;
+        out._bytes.resize(packed_detail::k_header_size + n * sizeof(T));
+        out._bytes[0] = static_cast<std::uint8_t>(packed_traits<T>::dtype);
+        out._bytes[1] = 0;
+
+        std::uint8_t* p = out._bytes.data() + packed_detail::k_header_size;
+
+        for (std::size_t i = 0; i < n; i++, p += sizeof(T)) {
+            packed_detail::store(p, values[i]);
+        }
+
+        return out;
+    }
+
+    template <typename T, typename Alloc>
+    static packed_vector pack(const std::vector<T, Alloc>& values) {
+        return pack(values.data(), values.size());
+    }
+
+    /// A binary value pointing into this packed_vector, which must outlive it.
+    types::b_binary binary() const {
+        return types::b_binary{_sub_type, static_cast<std::uint32_t>(_bytes.size()),
+                               _bytes.data()};
+    }
+
+   private:
+    binary_sub_type _sub_type;
+    std::vector<std::uint8_t> _bytes;
+};
+
+/// A typed, read-only view of the values of a packed vector, pointing straight into the document.
+///
+/// Documents give no alignment guarantees for binary values, so elements are read with unaligned
+/// loads, which are as cheap as aligned ones on the platforms we target. When aligned() holds,
+/// data() can also be handed to code that expects a plain array.
+template <typename T>
+class packed_span {
+   public:
+    /// Returns a disengaged optional unless the binary value is a packed vector of T.
+    static mongo::driver::optional<packed_span> from(const types::b_binary& binary) {
+        if (binary.sub_type != packed_traits<T>::sub_type ||
+            binary.size < packed_detail::k_header_size ||
+            binary.bytes[0] != static_cast<std::uint8_t>(packed_traits<T>::dtype) ||
+            (binary.size - packed_detail::k_header_size) % sizeof(T) != 0) {
+            return mongo::driver::nullopt;
+        }
+
+        return packed_span{binary.bytes + packed_detail::k_header_size,
+                           (binary.size - packed_detail::k_header_size) / sizeof(T)};
+    }
+
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    T operator[](std::size_t i) const { return packed_detail::load<T>(_bytes + i * sizeof(T)); }
+
+    /// Whether data() may be used.
+    bool aligned() const {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return false;
+#else
+        return reinterpret_cast<std::uintptr_t>(_bytes) % alignof(T) == 0;
+#endif
+    }
+
+    /// The values as a native array. Only valid when aligned().
+    const T* data() const { return reinterpret_cast<const T*>(_bytes); }
+
+    void copy_to(T* out) const {
+        for (std::size_t i = 0; i < _size; i++) {
+            out[i] = (*this)[i];
+        }
+    }
+
+   private:
+    packed_span(const std::uint8_t* bytes, std::size_t size) : _bytes(bytes), _size(size) {}
+
+    const std::uint8_t* _bytes;
+    std::size_t _size;
+};
+
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
@@ -0,0 +1,367 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bson/sort_key.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "bson/types.hpp"
+
+namespace bson {
+
+namespace {
+
+// The server's canonical type order. Types within one class, such as the numeric types, are
+// compared by value.
+enum class canonical : std::uint8_t {
+    k_minkey = 1,
+    k_undefined,
+    k_null,
+    k_number,
+    k_string,
+    k_document,
+    k_array,
+    k_binary,
+    k_oid,
+    k_bool,
+    k_date,
+    k_timestamp,
+    k_regex,
+    k_dbpointer,
+    k_code,
+    k_codewscope,
+    k_maxkey,
+};
+
+canonical canonical_type(type t) {
+    switch (t) {
+        case type::k_minkey:
+            return canonical::k_minkey;
+        case type::k_undefined:
+            return canonical::k_undefined;
+        case type::k_eod:
+        case type::k_null:
+            return canonical::k_null;
+        case type::k_double:
+        case type::k_int32:
+        case type::k_int64:
+            return canonical::k_number;
+        case type::k_utf8:
+        case type::k_symbol:
+            return canonical::k_string;
+        case type::k_document:
+            return canonical::k_document;
+        case type::k_array:
+            return canonical::k_array;
+        case type::k_binary:
+            return canonical::k_binary;
+        case type::k_oid:
+            return canonical::k_oid;
+        case type::k_bool:
+            return canonical::k_bool;
+        case type::k_date:
+            return canonical::k_date;
+        case type::k_timestamp:
+            return canonical::k_timestamp;
+        case type::k_regex:
+            return canonical::k_regex;
+        case type::k_dbpointer:
+            return canonical::k_dbpointer;
+        case type::k_code:
+            return canonical::k_code;
+        case type::k_codewscope:
+            return canonical::k_codewscope;
+        case type::k_maxkey:
+            return canonical::k_maxkey;
+    }
+
+    throw std::runtime_error("unknown bson type in sort key");
+}
+
+void put_be64(std::uint64_t v, std::string* out) {
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        out->push_back(static_cast<char>(v >> shift));
+    }
+}
+
+void put_be32(std::uint32_t v, std::string* out) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out->push_back(static_cast<char>(v >> shift));
+    }
+}
+
+// Flipping the sign bit makes two's complement integers compare as unsigned.
+void put_int64(std::int64_t v, std::string* out) {
+    put_be64(static_cast<std::uint64_t>(v) ^ (std::uint64_t{1} << 63), out);
+}
+
+// Positive doubles compare like their bit patterns once the sign bit is set, and negative ones
+// compare in reverse, so their bits are inverted. NaN sorts below every other number, as on the
+// server.
+void put_double(double v, std::string* out) {
+    if (std::isnan(v)) {
+        put_be64(0, out);
+        return;
+    }
+
+    if (v == 0) {
+        v = 0;  // -0.0 and 0.0 are equal.
+    }
+
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+
+    put_be64(bits >> 63 ? ~bits : bits | (std::uint64_t{1} << 63), out);
+}
+
+// Numbers are written as the nearest double followed by the exact distance of the value from
+// that double. The distance is only ever non-zero for int64 values too large to be represented
+// exactly, and it breaks ties between them and the doubles they round to.
+void put_number(double rounded, std::int64_t delta, std::string* out) {
+    put_double(rounded, out);
+    put_int64(delta, out);
+}
+
+void put_int(std::int64_t v, std::string* out) {
+    double rounded = static_cast<double>(v);
+
+    // 2^63 rounds from INT64_MAX and cannot be converted back.
+    if (rounded >= 9223372036854775808.0) {
+        put_number(rounded, (v - std::numeric_limits<std::int64_t>::max()) - 1, out);
+    } else {
+        put_number(rounded, v - static_cast<std::int64_t>(rounded), out);
+    }
+}
+
+// Strings are NUL terminated with the NULs inside them escaped, so no key is a prefix of
+// another and shorter strings still sort first.
+void put_string(const char* str, std::size_t len, std::string* out) {
+    for (std::size_t i = 0; i < len; i++) {
+        out->push_back(str[i]);
+
+        if (str[i] == '\0') {
+            out->push_back('\xff');
+        }
+    }
+
+    out->push_back('\0');
+    out->push_back('\0');
+}
+
+void put_string(const string_or_literal& str, std::string* out) {
+    put_string(str.c_str(), str.length(), out);
+}
+
+void put_value(const document::element& e, std::string* out);
+
+void put_document(const document::view& doc, bool with_keys, std::string* out) {
+    for (auto&& e : doc) {
+        out->push_back(static_cast<char>(canonical_type(e.type())));
+
+        if (with_keys) {
+            put_string(e.key(), out);
+        }
+
+        put_value(e, out);
+    }
+
+    out->push_back('\0');
+}
+
+void put_value(const document::element& e, std::string* out) {
+    switch (e.type()) {
+        case type::k_eod:
+        case type::k_undefined:
+        case type::k_null:
+        case type::k_minkey:
+        case type::k_maxkey:
+            break;
+        case type::k_double: {
+            double v = e.get_double().value;
+
+            put_number(v, 0, out);
+            break;
+        }
+        case type::k_int32:
+            put_int(e.get_int32().value, out);
+            break;
+        case type::k_int64:
+            put_int(e.get_int64().value, out);
+            break;
+        case type::k_utf8:
+            put_string(e.get_utf8().value, out);
+            break;
+        case type::k_symbol:
+            put_string(e.get_symbol().symbol, out);
+            break;
+        case type::k_document:
+            put_document(e.get_document().value, true, out);
+            break;
+        case type::k_array:
+            put_document(e.get_array().value, false, out);
+            break;
+        case type::k_binary: {
+            types::b_binary v = e.get_binary();
+
+            // The server compares length, then subtype, then bytes.
+            put_be32(v.size, out);
+            out->push_back(static_cast<char>(v.sub_type));
+            out->append(reinterpret_cast<const char*>(v.bytes), v.size);
+            break;
+        }
+        case type::k_oid:
+            out->append(e.get_oid().value.bytes(), oid::k_size);
+            break;
+        case type::k_bool:
+            out->push_back(e.get_bool().value ? 1 : 0);
+            break;
+        case type::k_date:
+            put_int64(e.get_date().value, out);
+            break;
+        case type::k_timestamp: {
+            types::b_timestamp v = e.get_timestamp();
+
+            put_be32(v.timestamp, out);
+            put_be32(v.increment, out);
+            break;
+        }
+        case type::k_regex: {
+            types::b_regex v = e.get_regex();
+
+            put_string(v.regex, out);
+            put_string(v.options, out);
+            break;
+        }
+        case type::k_dbpointer: {
+            types::b_dbpointer v = e.get_dbpointer();
+
+            put_string(v.collection, out);
+            out->append(v.value.bytes(), oid::k_size);
+            break;
+        }
+        case type::k_code:
+            put_string(e.get_code().code, out);
+            break;
+        case type::k_codewscope: {
+            types::b_codewscope v = e.get_codewscope();
+
+            put_string(v.code, out);
+            put_document(v.scope, true, out);
+            break;
+        }
+    }
+}
+
+document::element child(const document::view& doc, const char* key, std::size_t len) {
+    for (auto&& e : doc) {
+        string_or_literal k = e.key();
+
+        if (k.length() == len && std::memcmp(k.c_str(), key, len) == 0) {
+            return e;
+        }
+    }
+
+    return document::element{};
+}
+
+// Follows a dotted path through documents and arrays. Returns an element of type k_eod if any
+// part of the path is missing.
+document::element lookup(const document::view& doc, const std::string& path) {
+    document::view current = doc;
+    std::size_t start = 0;
+
+    for (;;) {
+        std::size_t dot = path.find('.', start);
+        std::size_t end = dot == std::string::npos ? path.length() : dot;
+
+        document::element e = child(current, path.c_str() + start, end - start);
+
+        if (dot == std::string::npos) {
+            return e;
+        }
+
+        switch (e.type()) {
+            case type::k_document:
+                current = e.get_document().value;
+                break;
+            case type::k_array:
+                current = e.get_array().value;
+                break;
+            default:
+                return document::element{};
+        }
+
+        start = dot + 1;
+    }
+}
+
+}  // namespace
+
+sort_key_encoder::sort_key_encoder(const document::view& spec) {
+    for (auto&& e : spec) {
+        double direction;
+
+        switch (e.type()) {
+            case type::k_int32:
+                direction = e.get_int32().value;
+                break;
+            case type::k_int64:
+                direction = static_cast<double>(e.get_int64().value);
+                break;
+            case type::k_double:
+                direction = e.get_double().value;
+                break;
+            default:
+                throw std::runtime_error("sort directions must be numbers");
+        }
+
+        if (direction == 0 || std::isnan(direction)) {
+            throw std::runtime_error("sort directions must be 1 or -1");
+        }
+
+        string_or_literal key = e.key();
+        _fields.push_back(field{std::string{key.c_str(), key.length()}, direction < 0});
+    }
+}
+
+void sort_key_encoder::encode_value(const document::element& value, std::string* out) {
+    out->push_back(static_cast<char>(canonical_type(value.type())));
+    put_value(value, out);
+}
+
+void sort_key_encoder::encode(const document::view& doc, std::string* out) const {
+    for (auto&& f : _fields) {
+        std::size_t start = out->length();
+
+        encode_value(lookup(doc, f.path), out);
+
+        if (f.descending) {
+            for (std::size_t i = start; i < out->length(); i++) {
+                (*out)[i] = static_cast<char>(~(*out)[i]);
+            }
+        }
+    }
+}
+
+std::string sort_key_encoder::encode(const document::view& doc) const {
+    std::string out;
+    encode(doc, &out);
+    return out;
+}
+
+}  // namespace bson
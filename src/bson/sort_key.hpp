@@ -0,0 +1,63 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <string>
+#include <vector>
+
+#include "bson/document/view.hpp"
+
+namespace bson {
+
+/// Turns the values at a set of paths into byte strings whose memcmp order is the order the
+/// server would sort the documents in.
+///
+/// Values are ordered first by the server's canonical type order (minkey, null, numbers, strings,
+/// documents, arrays, binary, oid, bool, date, timestamp, regex, maxkey), numbers are compared by
+/// value across int32, int64 and double, and missing fields sort as null. Descending fields have
+/// their bytes inverted. Once encoded, documents can be sorted, merged or partitioned on the keys
+/// alone, without looking at the documents again.
+///
+/// Strings compare bytewise, as under the simple collation. Arrays are compared as whole values,
+/// rather than by their smallest or largest element as the server does for sorts.
+class LIBMONGOCXX_EXPORT sort_key_encoder {
+   public:
+    /// Takes a sort specification in the server's format, such as {a: 1, "b.c": -1}.
+    explicit sort_key_encoder(const document::view& spec);
+
+    /// Appends the key of doc to out.
+    void encode(const document::view& doc, std::string* out) const;
+
+    std::string encode(const document::view& doc) const;
+
+    /// Appends the key of a single value, type included, as it would appear for an ascending
+    /// field. Two values compare equal under the server's rules exactly when their keys are
+    /// equal.
+    static void encode_value(const document::element& value, std::string* out);
+
+   private:
+    struct field {
+        std::string path;
+        bool descending;
+    };
+
+    std::vector<field> _fields;
+};
+
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
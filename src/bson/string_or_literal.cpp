@@ -22,7 +22,10 @@ string_or_literal::string_or_literal() : _len(0), _is_owning(false), _literal(""
 string_or_literal::string_or_literal(const char* str, std::size_t len)
     : _len(len), _is_owning(false), _literal(str) {}
 
-string_or_literal::string_or_literal(std::string v)
+string_or_literal::string_or_literal(const std::string& v)
+    : _len(v.length()), _is_owning(false), _literal(v.c_str()) {}
+
+string_or_literal::string_or_literal(std::string&& v)
     : _len(v.length()), _is_owning(true), _string(std::move(v)) {}
 
 string_or_literal& string_or_literal::operator=(const string_or_literal& rhs) {
@@ -93,6 +96,12 @@ const char* string_or_literal::c_str() const {
     }
 }
 
+bool string_or_literal::is_owning() const { return _is_owning; }
+
+string_or_literal string_or_literal::to_owned() const {
+    return string_or_literal{std::string{c_str(), _len}};
+}
+
 std::ostream& operator<<(std::ostream& out, const string_or_literal& rhs) {
     out << "\"" << rhs.c_str() << "\"";
 
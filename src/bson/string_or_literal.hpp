@@ -20,13 +20,19 @@
 
 namespace bson {
 
+/// A string that is either borrowed or owned.
+///
+/// Literals, (pointer, length) pairs and std::string lvalues are borrowed without copying, and
+/// must outlive the string_or_literal. Ownership is only taken of std::string rvalues, which are
+/// moved in, or when asked for with to_owned().
 class string_or_literal {
    public:
     template <std::size_t n>
     constexpr string_or_literal(const char (&v)[n])
         : _len(n - 1), _is_owning(false), _literal(v) {}
 
-    string_or_literal(std::string v);
+    string_or_literal(const std::string& v);
+    string_or_literal(std::string&& v);
     string_or_literal(const char* str, std::size_t len);
 
     string_or_literal();
@@ -41,6 +47,11 @@ class string_or_literal {
     std::size_t length() const;
     const char* c_str() const;
 
+    bool is_owning() const;
+
+    /// Returns a copy that owns its bytes, for keeping a borrowed string past its source.
+    string_or_literal to_owned() const;
+
     friend std::ostream& operator<<(std::ostream& out, const string_or_literal& rhs);
 
    private:
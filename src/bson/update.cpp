@@ -0,0 +1,630 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bson/update.hpp"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bson/document/editor.hpp"
+#include "bson/encoder.hpp"
+#include "bson/sort_key.hpp"
+#include "bson/types.hpp"
+#include "bson/util/itoa.hpp"
+#include "bson/util/raw.hpp"
+
+namespace bson {
+
+namespace {
+
+enum class op_kind {
+    k_set,
+    k_unset,
+    k_inc,
+    k_mul,
+    k_min,
+    k_max,
+    k_push,
+    k_add_to_set,
+    k_pull,
+};
+
+struct op_name {
+    const char* name;
+    op_kind kind;
+};
+
+const op_name kOps[] = {
+    {"$set", op_kind::k_set},
+    {"$unset", op_kind::k_unset},
+    {"$inc", op_kind::k_inc},
+    {"$mul", op_kind::k_mul},
+    {"$min", op_kind::k_min},
+    {"$max", op_kind::k_max},
+    {"$push", op_kind::k_push},
+    {"$addToSet", op_kind::k_add_to_set},
+    {"$pull", op_kind::k_pull},
+};
+
+bool same(const string_or_literal& a, const char* b, std::size_t len) {
+    return a.length() == len && std::memcmp(a.c_str(), b, len) == 0;
+}
+
+// One segment of an update path. Leaves carry an operator, inner nodes the segments below them,
+// in the order they first appear in the update.
+struct op_node {
+    std::string key;
+
+    bool leaf = false;
+    op_kind kind = op_kind::k_set;
+    document::element arg;
+
+    std::vector<std::unique_ptr<op_node>> children;
+
+    op_node* child(const char* k, std::size_t len) const {
+        for (auto&& c : children) {
+            if (c->key.length() == len && std::memcmp(c->key.data(), k, len) == 0) {
+                return c.get();
+            }
+        }
+
+        return nullptr;
+    }
+};
+
+void add_op(op_node* root, op_kind kind, const string_or_literal& path,
+            const document::element& arg) {
+    op_node* node = root;
+    const char* segment = path.c_str();
+    const char* end = segment + path.length();
+
+    for (;;) {
+        const char* dot = static_cast<const char*>(std::memchr(segment, '.', end - segment));
+        const char* segment_end = dot ? dot : end;
+
+        if (segment == segment_end) {
+            throw std::runtime_error(std::string("empty field name in update path: ") +
+                                     path.c_str());
+        }
+
+        if (node->leaf) {
+            throw std::runtime_error(std::string("conflicting update paths at: ") + path.c_str());
+        }
+
+        op_node* next = node->child(segment, segment_end - segment);
+
+        if (!next) {
+            node->children.emplace_back(new op_node);
+            next = node->children.back().get();
+            next->key.assign(segment, segment_end - segment);
+        }
+
+        node = next;
+
+        if (!dot) {
+            break;
+        }
+
+        segment = dot + 1;
+    }
+
+    if (node->leaf || !node->children.empty()) {
+        throw std::runtime_error(std::string("conflicting update paths at: ") + path.c_str());
+    }
+
+    node->leaf = true;
+    node->kind = kind;
+    node->arg = arg;
+}
+
+struct number {
+    type t;
+    std::int64_t i;
+    double d;
+};
+
+bool read_number(const document::element& e, number* out) {
+    switch (e.type()) {
+        case type::k_int32:
+            *out = number{type::k_int32, e.get_int32().value, 0};
+            return true;
+        case type::k_int64:
+            *out = number{type::k_int64, e.get_int64().value, 0};
+            return true;
+        case type::k_double:
+            *out = number{type::k_double, 0, e.get_double().value};
+            return true;
+        default:
+            return false;
+    }
+}
+
+double as_double(const number& n) { return n.t == type::k_double ? n.d : static_cast<double>(n.i); }
+
+number numeric_arg(const op_node& op) {
+    number n;
+
+    if (!read_number(op.arg, &n)) {
+        const char* name = op.kind == op_kind::k_inc ? "$inc" : "$mul";
+        throw std::runtime_error(std::string("cannot ") + name + " by a non-numeric value at: " +
+                                 op.key);
+    }
+
+    return n;
+}
+
+// Follows the server's promotion rules: doubles win, then int64, and int32 results that
+// overflow widen to int64. int64 overflow is an error.
+number arithmetic(op_kind kind, const number& a, const number& b) {
+    if (a.t == type::k_double || b.t == type::k_double) {
+        double x = as_double(a);
+        double y = as_double(b);
+
+        return number{type::k_double, 0, kind == op_kind::k_inc ? x + y : x * y};
+    }
+
+    std::int64_t result;
+    bool overflow = kind == op_kind::k_inc ? __builtin_add_overflow(a.i, b.i, &result)
+                                           : __builtin_mul_overflow(a.i, b.i, &result);
+
+    if (overflow) {
+        throw std::runtime_error("integer overflow applying update");
+    }
+
+    if (a.t == type::k_int32 && b.t == type::k_int32 &&
+        result >= std::numeric_limits<std::int32_t>::min() &&
+        result <= std::numeric_limits<std::int32_t>::max()) {
+        return number{type::k_int32, result, 0};
+    }
+
+    return number{type::k_int64, result, 0};
+}
+
+number apply_numeric(const op_node& op, const document::element& current) {
+    number value;
+
+    if (!read_number(current, &value)) {
+        throw std::runtime_error("cannot apply arithmetic to a non-numeric field at: " + op.key);
+    }
+
+    return arithmetic(op.kind, value, numeric_arg(op));
+}
+
+std::string value_key(const document::element& e) {
+    std::string key;
+    sort_key_encoder::encode_value(e, &key);
+    return key;
+}
+
+// Whether $min or $max would replace the current value with the argument.
+bool replaces(const op_node& op, const document::element& current) {
+    int cmp = value_key(op.arg).compare(value_key(current));
+
+    return op.kind == op_kind::k_min ? cmp < 0 : cmp > 0;
+}
+
+util::raw::element raw_of(const document::element& e) {
+    util::raw::element r;
+
+    if (!util::raw::read(e.raw(), e.length(), e.offset(), &r)) {
+        throw std::runtime_error("malformed element in update");
+    }
+
+    return r;
+}
+
+void copy_element(encoder& out, const document::element& e) {
+    util::raw::element r = raw_of(e);
+    out.write(e.raw() + r.offset, r.end() - r.offset);
+}
+
+void write_value(encoder& out, const char* key, std::size_t len, const document::element& v) {
+    util::raw::element r = raw_of(v);
+
+    out.element(v.type(), key, len);
+    out.write(v.raw() + r.value_offset, r.value_len);
+}
+
+void write_number(encoder& out, const char* key, std::size_t len, const number& n) {
+    switch (n.t) {
+        case type::k_int32:
+            out.append(key, len, static_cast<std::int32_t>(n.i));
+            break;
+        case type::k_int64:
+            out.append(key, len, n.i);
+            break;
+        default:
+            out.append(key, len, n.d);
+            break;
+    }
+}
+
+// The values a $push or $addToSet adds, unwrapping $each.
+std::vector<document::element> items_of(const op_node& op) {
+    std::vector<document::element> items;
+
+    if (op.arg.type() == type::k_document) {
+        document::view arg = op.arg.get_document().value;
+        auto first = arg.begin();
+
+        if (first != arg.end() && first->key_data()[0] == '$') {
+            for (auto&& modifier : arg) {
+                if (!same(modifier.key(), "$each", 5) || modifier.type() != type::k_array) {
+                    throw std::runtime_error(
+                        "only $each is supported as an array update modifier");
+                }
+
+                for (auto&& item : modifier.get_array().value) {
+                    items.push_back(item);
+                }
+            }
+
+            return items;
+        }
+    }
+
+    items.push_back(op.arg);
+    return items;
+}
+
+// Writes the array that results from an array operator, starting from the current array, or
+// from nothing if the field is missing.
+void write_array(encoder& out, const char* key, std::size_t len, const op_node& op,
+                 const document::view* current) {
+    out.element(type::k_array, key, len);
+    std::size_t offset = out.open();
+    std::uint32_t index = 0;
+
+    auto put = [&](const document::element& v) {
+        util::itoa k(index++);
+        write_value(out, k.c_str(), k.length(), v);
+    };
+
+    if (op.kind == op_kind::k_pull) {
+        if (op.arg.type() == type::k_document) {
+            document::view arg = op.arg.get_document().value;
+
+            if (arg.begin() != arg.end() && arg.begin()->key_data()[0] == '$') {
+                throw std::runtime_error("$pull only supports removal by equality");
+            }
+        }
+
+        std::string target = value_key(op.arg);
+
+        if (current) {
+            for (auto&& v : *current) {
+                if (value_key(v) != target) {
+                    put(v);
+                }
+            }
+        }
+    } else {
+        std::vector<document::element> items = items_of(op);
+        std::set<std::string> seen;
+
+        if (current) {
+            for (auto&& v : *current) {
+                if (op.kind == op_kind::k_add_to_set) {
+                    seen.insert(value_key(v));
+                }
+
+                put(v);
+            }
+        }
+
+        for (auto&& v : items) {
+            if (op.kind == op_kind::k_push || seen.insert(value_key(v)).second) {
+                put(v);
+            }
+        }
+    }
+
+    out.close(offset);
+}
+
+// Whether applying the operators below a missing field would create it. $unset and $pull
+// leave missing fields alone.
+bool creates(const op_node& op) {
+    if (op.leaf) {
+        return op.kind != op_kind::k_unset && op.kind != op_kind::k_pull;
+    }
+
+    for (auto&& c : op.children) {
+        if (creates(*c)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Writes the field for an operator whose target does not exist yet.
+void create(encoder& out, const op_node& op) {
+    const char* key = op.key.data();
+    std::size_t len = op.key.length();
+
+    if (!creates(op)) {
+        return;
+    }
+
+    if (!op.leaf) {
+        out.element(type::k_document, key, len);
+        std::size_t offset = out.open();
+
+        for (auto&& c : op.children) {
+            create(out, *c);
+        }
+
+        out.close(offset);
+        return;
+    }
+
+    switch (op.kind) {
+        case op_kind::k_set:
+        case op_kind::k_min:
+        case op_kind::k_max:
+            write_value(out, key, len, op.arg);
+            break;
+        case op_kind::k_inc:
+            write_number(out, key, len, numeric_arg(op));
+            break;
+        case op_kind::k_mul: {
+            number zero = numeric_arg(op);
+            zero.i = 0;
+            zero.d = 0;
+            write_number(out, key, len, zero);
+            break;
+        }
+        case op_kind::k_push:
+        case op_kind::k_add_to_set:
+            write_array(out, key, len, op, nullptr);
+            break;
+        case op_kind::k_unset:
+        case op_kind::k_pull:
+            break;
+    }
+}
+
+document::element find_child(const document::view& doc, const char* key, std::size_t len) {
+    for (auto&& e : doc) {
+        if (same(e.key(), key, len)) {
+            return e;
+        }
+    }
+
+    return document::element{};
+}
+
+bool is_container(type t) { return t == type::k_document || t == type::k_array; }
+
+document::view container_of(const document::element& e) {
+    return e.type() == type::k_document ? e.get_document().value : e.get_array().value;
+}
+
+void apply_existing(encoder& out, const op_node& op, const document::element& current,
+                    bool in_array) {
+    const char* key = op.key.data();
+    std::size_t len = op.key.length();
+
+    switch (op.kind) {
+        case op_kind::k_set:
+            write_value(out, key, len, op.arg);
+            break;
+        case op_kind::k_unset:
+            // Removing an array element would renumber the rest, so the server nulls it instead.
+            if (in_array) {
+                out.append(key, len, types::b_null{});
+            }
+            break;
+        case op_kind::k_inc:
+        case op_kind::k_mul:
+            write_number(out, key, len, apply_numeric(op, current));
+            break;
+        case op_kind::k_min:
+        case op_kind::k_max:
+            write_value(out, key, len, replaces(op, current) ? op.arg : current);
+            break;
+        case op_kind::k_push:
+        case op_kind::k_add_to_set:
+        case op_kind::k_pull: {
+            if (current.type() != type::k_array) {
+                throw std::runtime_error("cannot apply an array update to a non-array field at: " +
+                                         op.key);
+            }
+
+            document::view items = current.get_array().value;
+            write_array(out, key, len, op, &items);
+            break;
+        }
+    }
+}
+
+void rewrite(encoder& out, const document::view& doc, const op_node& node, bool in_array) {
+    std::vector<bool> used(node.children.size());
+    std::uint32_t count = 0;
+
+    for (auto&& e : doc) {
+        string_or_literal key = e.key();
+        std::size_t i = 0;
+
+        count++;
+
+        while (i < node.children.size() && !same(key, node.children[i]->key.data(),
+                                                  node.children[i]->key.length())) {
+            i++;
+        }
+
+        if (i == node.children.size()) {
+            copy_element(out, e);
+            continue;
+        }
+
+        used[i] = true;
+        const op_node& op = *node.children[i];
+
+        if (op.leaf) {
+            apply_existing(out, op, e, in_array);
+        } else if (is_container(e.type())) {
+            out.element(e.type(), key.c_str(), key.length());
+            std::size_t offset = out.open();
+            rewrite(out, container_of(e), op, e.type() == type::k_array);
+            out.close(offset);
+        } else {
+            throw std::runtime_error("cannot update a field inside a non-document value at: " +
+                                     op.key);
+        }
+    }
+
+    for (std::size_t i = 0; i < node.children.size(); i++) {
+        const op_node& op = *node.children[i];
+
+        if (used[i] || !creates(op)) {
+            continue;
+        }
+
+        if (in_array) {
+            util::itoa next(count++);
+
+            if (op.key != next.c_str()) {
+                throw std::runtime_error("can only append to the end of an array, not at: " +
+                                         op.key);
+            }
+        }
+
+        create(out, op);
+    }
+}
+
+// A change that can be made with the editor, worked out before anything is modified so that a
+// failure part way leaves the document untouched.
+struct planned_edit {
+    std::string path;
+    bool is_number;
+    number n;
+    document::element value;
+};
+
+bool plan_edits(const op_node& node, const document::view& doc, std::string* path,
+                std::vector<planned_edit>* plan) {
+    for (auto&& c : node.children) {
+        document::element current = find_child(doc, c->key.data(), c->key.length());
+
+        if (current.type() == type::k_eod) {
+            return false;
+        }
+
+        std::size_t path_len = path->length();
+
+        if (!path->empty()) {
+            path->push_back('.');
+        }
+
+        path->append(c->key);
+
+        if (!c->leaf) {
+            if (!is_container(current.type()) ||
+                !plan_edits(*c, container_of(current), path, plan)) {
+                return false;
+            }
+        } else {
+            switch (c->kind) {
+                case op_kind::k_set:
+                    plan->push_back(planned_edit{*path, false, number{}, c->arg});
+                    break;
+                case op_kind::k_min:
+                case op_kind::k_max:
+                    if (replaces(*c, current)) {
+                        plan->push_back(planned_edit{*path, false, number{}, c->arg});
+                    }
+                    break;
+                case op_kind::k_inc:
+                case op_kind::k_mul:
+                    plan->push_back(planned_edit{*path, true, apply_numeric(*c, current),
+                                                 document::element{}});
+                    break;
+                default:
+                    return false;
+            }
+        }
+
+        path->resize(path_len);
+    }
+
+    return true;
+}
+
+}  // namespace
+
+void apply_update(document::value& doc, const document::view& update) {
+    op_node root;
+
+    for (auto&& group : update) {
+        string_or_literal name = group.key();
+        const op_name* op = nullptr;
+
+        for (auto&& candidate : kOps) {
+            if (same(name, candidate.name, std::strlen(candidate.name))) {
+                op = &candidate;
+            }
+        }
+
+        if (!op) {
+            throw std::runtime_error(std::string("unsupported update operator: ") + name.c_str());
+        }
+
+        if (group.type() != type::k_document) {
+            throw std::runtime_error(std::string("the argument of ") + name.c_str() +
+                                     " must be a document");
+        }
+
+        for (auto&& field : group.get_document().value) {
+            add_op(&root, op->kind, field.key(), field);
+        }
+    }
+
+    std::vector<planned_edit> plan;
+    std::string path;
+
+    if (plan_edits(root, doc.view(), &path, &plan)) {
+        document::editor editor{doc};
+
+        for (auto&& edit : plan) {
+            if (!edit.is_number) {
+                editor.set(edit.path, edit.value);
+            } else if (edit.n.t == type::k_int32) {
+                editor.set(edit.path, types::b_int32{static_cast<std::int32_t>(edit.n.i)});
+            } else if (edit.n.t == type::k_int64) {
+                editor.set(edit.path, types::b_int64{edit.n.i});
+            } else {
+                editor.set(edit.path, types::b_double{edit.n.d});
+            }
+        }
+
+        return;
+    }
+
+    encoder out;
+    out.begin();
+    rewrite(out, doc.view(), root, false);
+    out.finish();
+
+    doc = out.extract();
+}
+
+}  // namespace bson
@@ -0,0 +1,40 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include "bson/document.hpp"
+
+namespace bson {
+
+/// Applies an update document, as would be sent with update_one or update_many, to a local copy
+/// of a document.
+///
+/// Supports $set, $unset, $inc, $mul, $min, $max, $push (with $each), $addToSet (with $each) and
+/// $pull (by equality, not by query) with dotted paths. Comparisons and equality follow the
+/// server's rules, so that 1, 1L and 1.0 are equal.
+///
+/// When every operator targets an existing field and no field is added or removed, the changes
+/// are made with a document::editor, in place where the sizes allow. Otherwise the document is
+/// rewritten once with every operator applied.
+///
+/// Throws std::runtime_error for unsupported operators, conflicting paths, arithmetic on
+/// non-numeric values or overflow, leaving the document unchanged.
+LIBMONGOCXX_EXPORT void apply_update(document::value& doc, const document::view& update);
+
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
@@ -0,0 +1,79 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace bson {
+namespace util {
+
+/// Loads and stores of the little endian integers and doubles that make up the BSON wire format.
+/// These are only for code that reads or writes raw document bytes without going through libbson.
+
+inline std::uint16_t byteswap(std::uint16_t v) { return __builtin_bswap16(v); }
+inline std::uint32_t byteswap(std::uint32_t v) { return __builtin_bswap32(v); }
+inline std::uint64_t byteswap(std::uint64_t v) { return __builtin_bswap64(v); }
+
+template <typename T>
+inline T to_le(T v) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return byteswap(v);
+#else
+    return v;
+#endif
+}
+
+inline std::int32_t load_int32(const std::uint8_t* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return static_cast<std::int32_t>(to_le(v));
+}
+
+inline std::int64_t load_int64(const std::uint8_t* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return static_cast<std::int64_t>(to_le(v));
+}
+
+inline double load_double(const std::uint8_t* p) {
+    std::uint64_t v = static_cast<std::uint64_t>(load_int64(p));
+    double d;
+    std::memcpy(&d, &v, sizeof(d));
+    return d;
+}
+
+inline void store_int32(std::uint8_t* p, std::int32_t value) {
+    std::uint32_t v = to_le(static_cast<std::uint32_t>(value));
+    std::memcpy(p, &v, sizeof(v));
+}
+
+inline void store_int64(std::uint8_t* p, std::int64_t value) {
+    std::uint64_t v = to_le(static_cast<std::uint64_t>(value));
+    std::memcpy(p, &v, sizeof(v));
+}
+
+inline void store_double(std::uint8_t* p, double value) {
+    std::uint64_t v;
+    std::memcpy(&v, &value, sizeof(v));
+    store_int64(p, static_cast<std::int64_t>(v));
+}
+
+}  // namespace util
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
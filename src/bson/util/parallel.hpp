@@ -0,0 +1,77 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace bson {
+namespace util {
+
+/// Calls fn(0) to fn(n - 1) at the same time, fn(0) on the calling thread and the others on
+/// threads of their own. Returns once all of them are done, rethrowing the first exception any of
+/// them threw. If a thread cannot be started, the ones already running are joined before the
+/// std::system_error is rethrown.
+inline void run_parallel(std::size_t n, const std::function<void(std::size_t)>& fn) {
+    std::vector<std::exception_ptr> errors(n);
+    std::vector<std::thread> threads;
+
+    auto guarded = [&](std::size_t i) {
+        try {
+            fn(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    auto join = [&] {
+        for (auto&& thread : threads) {
+            thread.join();
+        }
+    };
+
+    try {
+        threads.reserve(n);
+
+        for (std::size_t i = 1; i < n; i++) {
+            threads.emplace_back(guarded, i);
+        }
+    } catch (...) {
+        join();
+        throw;
+    }
+
+    if (n > 0) {
+        guarded(0);
+    }
+
+    join();
+
+    for (auto&& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace util
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
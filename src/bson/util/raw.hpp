@@ -0,0 +1,168 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "bson/types.hpp"
+#include "bson/util/endian.hpp"
+
+namespace bson {
+namespace util {
+namespace raw {
+
+/// The location of one element inside a document's bytes. Unlike document::element this exposes
+/// byte offsets, for code that rewrites documents in place.
+struct element {
+    bson::type type;
+    /// Offset of the type byte, relative to the start of the document.
+    std::size_t offset;
+    const char* key;
+    std::size_t key_len;
+    /// Offset of the value, just past the key's terminating NUL.
+    std::size_t value_offset;
+    std::size_t value_len;
+
+    std::size_t end() const { return value_offset + value_len; }
+};
+
+inline std::size_t overrun(bool* ok) {
+    *ok = false;
+    return 0;
+}
+
+/// Returns the size of a value of type t starting at p, with at most remaining bytes available.
+/// Sets ok to false if the type is unknown or the value overruns.
+inline std::size_t value_size(type t, const std::uint8_t* p, std::size_t remaining, bool* ok) {
+    std::size_t size;
+    *ok = true;
+
+    switch (t) {
+        case type::k_undefined:
+        case type::k_null:
+        case type::k_minkey:
+        case type::k_maxkey:
+            return 0;
+        case type::k_bool:
+            size = 1;
+            break;
+        case type::k_int32:
+            size = 4;
+            break;
+        case type::k_double:
+        case type::k_date:
+        case type::k_timestamp:
+        case type::k_int64:
+            size = 8;
+            break;
+        case type::k_oid:
+            size = 12;
+            break;
+        case type::k_utf8:
+        case type::k_code:
+        case type::k_symbol:
+            if (remaining < 4) return overrun(ok);
+            size = 4 + static_cast<std::uint32_t>(load_int32(p));
+            break;
+        case type::k_binary:
+            if (remaining < 4) return overrun(ok);
+            size = 5 + static_cast<std::uint32_t>(load_int32(p));
+            break;
+        case type::k_document:
+        case type::k_array:
+        case type::k_codewscope:
+            if (remaining < 4) return overrun(ok);
+            size = static_cast<std::uint32_t>(load_int32(p));
+            break;
+        case type::k_dbpointer:
+            if (remaining < 4) return overrun(ok);
+            size = 4 + static_cast<std::uint32_t>(load_int32(p)) + 12;
+            break;
+        case type::k_regex: {
+            const void* nul = std::memchr(p, '\0', remaining);
+            if (!nul) return overrun(ok);
+            std::size_t first = static_cast<const std::uint8_t*>(nul) - p + 1;
+            nul = std::memchr(p + first, '\0', remaining - first);
+            if (!nul) return overrun(ok);
+            size = static_cast<const std::uint8_t*>(nul) - p + 1;
+            break;
+        }
+        default:
+            return overrun(ok);
+    }
+
+    if (size > remaining) {
+        return overrun(ok);
+    }
+
+    return size;
+}
+
+/// Reads the element at pos within the document doc of doc_len bytes. Returns false at the end of
+/// the document or on malformed input.
+inline bool read(const std::uint8_t* doc, std::size_t doc_len, std::size_t pos, element* out) {
+    if (pos + 1 >= doc_len || doc[pos] == 0) {
+        return false;
+    }
+
+    const void* nul = std::memchr(doc + pos + 1, '\0', doc_len - pos - 1);
+
+    if (!nul) {
+        return false;
+    }
+
+    out->type = static_cast<type>(doc[pos]);
+    out->offset = pos;
+    out->key = reinterpret_cast<const char*>(doc + pos + 1);
+    out->key_len = static_cast<const std::uint8_t*>(nul) - (doc + pos + 1);
+    out->value_offset = pos + 1 + out->key_len + 1;
+
+    if (out->value_offset >= doc_len) {
+        return false;
+    }
+
+    bool ok;
+    // Leave room for the document's own trailing NUL.
+    out->value_len = value_size(out->type, doc + out->value_offset,
+                                doc_len - 1 - out->value_offset, &ok);
+
+    return ok;
+}
+
+/// Finds the element with the given key among the direct children of doc.
+inline bool find(const std::uint8_t* doc, std::size_t doc_len, const char* key,
+                 std::size_t key_len, element* out) {
+    std::size_t pos = 4;
+
+    while (read(doc, doc_len, pos, out)) {
+        if (out->key_len == key_len && std::memcmp(out->key, key, key_len) == 0) {
+            return true;
+        }
+
+        pos = out->end();
+    }
+
+    return false;
+}
+
+}  // namespace raw
+}  // namespace util
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
@@ -0,0 +1,355 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bson/validator.hpp"
+
+#include <bitset>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace bson {
+
+namespace {
+
+// Unknown type bytes map to no bit, so they fail every bsonType check instead of shifting out of
+// range.
+std::uint32_t type_bit(type t) {
+    switch (t) {
+        case type::k_maxkey:
+            return 1u << 30;
+        case type::k_minkey:
+            return 1u << 31;
+        default: {
+            std::uint8_t code = static_cast<std::uint8_t>(t);
+            return code < 30 ? 1u << code : 0;
+        }
+    }
+}
+
+struct type_name {
+    const char* name;
+    std::uint32_t bits;
+};
+
+const type_name kTypeNames[] = {
+    {"double", type_bit(type::k_double)},
+    {"string", type_bit(type::k_utf8)},
+    {"object", type_bit(type::k_document)},
+    {"array", type_bit(type::k_array)},
+    {"binData", type_bit(type::k_binary)},
+    {"undefined", type_bit(type::k_undefined)},
+    {"objectId", type_bit(type::k_oid)},
+    {"bool", type_bit(type::k_bool)},
+    {"date", type_bit(type::k_date)},
+    {"null", type_bit(type::k_null)},
+    {"regex", type_bit(type::k_regex)},
+    {"dbPointer", type_bit(type::k_dbpointer)},
+    {"javascript", type_bit(type::k_code)},
+    {"symbol", type_bit(type::k_symbol)},
+    {"javascriptWithScope", type_bit(type::k_codewscope)},
+    {"int", type_bit(type::k_int32)},
+    {"timestamp", type_bit(type::k_timestamp)},
+    {"long", type_bit(type::k_int64)},
+    {"minKey", type_bit(type::k_minkey)},
+    {"maxKey", type_bit(type::k_maxkey)},
+    {"number", type_bit(type::k_double) | type_bit(type::k_int32) | type_bit(type::k_int64)},
+};
+
+std::uint32_t type_bits(const document::element& e) {
+    if (e.type() != type::k_utf8) {
+        throw std::runtime_error("bsonType must be a string or an array of strings");
+    }
+
+    types::b_utf8 name = e.get_utf8();
+
+    for (auto&& t : kTypeNames) {
+        if (std::strlen(t.name) == name.value.length() &&
+            std::memcmp(t.name, name.value.c_str(), name.value.length()) == 0) {
+            return t.bits;
+        }
+    }
+
+    throw std::runtime_error(std::string("unknown bsonType: ") + name.value.c_str());
+}
+
+bool is_number(type t) {
+    return t == type::k_double || t == type::k_int32 || t == type::k_int64;
+}
+
+double number(const document::element& e) {
+    switch (e.type()) {
+        case type::k_double:
+            return e.get_double().value;
+        case type::k_int32:
+            return e.get_int32().value;
+        case type::k_int64:
+            return static_cast<double>(e.get_int64().value);
+        default:
+            throw std::runtime_error("expected a number in schema");
+    }
+}
+
+std::size_t count(const document::element& e) {
+    double n = number(e);
+
+    if (n < 0 || n != std::floor(n)) {
+        throw std::runtime_error("expected a non-negative integer in schema");
+    }
+
+    return static_cast<std::size_t>(n);
+}
+
+bool keyword(const string_or_literal& key, const char* name) {
+    return key.length() == std::strlen(name) && std::memcmp(key.c_str(), name, key.length()) == 0;
+}
+
+std::string child_path(const std::string& parent, const char* key, std::size_t len) {
+    std::string path = parent;
+
+    if (!path.empty()) {
+        path.push_back('.');
+    }
+
+    path.append(key, len);
+    return path;
+}
+
+// The length of a UTF-8 string in code points, as JSON schema counts it.
+std::size_t code_points(const char* str, std::size_t len) {
+    std::size_t n = 0;
+
+    for (std::size_t i = 0; i < len; i++) {
+        if ((static_cast<std::uint8_t>(str[i]) & 0xc0) != 0x80) {
+            n++;
+        }
+    }
+
+    return n;
+}
+
+}  // namespace
+
+constexpr std::size_t validator::k_max_properties;
+constexpr std::size_t validator::k_none;
+
+validator::validator(const document::view& schema) { compile(schema, std::string{}); }
+
+validator::validator(validator&&) = default;
+validator& validator::operator=(validator&&) = default;
+validator::~validator() = default;
+
+std::size_t validator::compile(const document::view& schema, const std::string& path) {
+    std::size_t n = _nodes.size();
+    _nodes.emplace_back();
+    _nodes[n].path = path;
+
+    document::view properties;
+    bool has_properties = false;
+
+    for (auto&& e : schema) {
+        string_or_literal key = e.key();
+
+        if (keyword(key, "bsonType")) {
+            if (e.type() == type::k_array) {
+                for (auto&& name : e.get_array().value) {
+                    _nodes[n].types |= type_bits(name);
+                }
+            } else {
+                _nodes[n].types = type_bits(e);
+            }
+        } else if (keyword(key, "minimum")) {
+            _nodes[n].has_minimum = true;
+            _nodes[n].minimum = number(e);
+        } else if (keyword(key, "maximum")) {
+            _nodes[n].has_maximum = true;
+            _nodes[n].maximum = number(e);
+        } else if (keyword(key, "minLength")) {
+            _nodes[n].min_length = count(e);
+        } else if (keyword(key, "maxLength")) {
+            _nodes[n].max_length = count(e);
+        } else if (keyword(key, "minItems")) {
+            _nodes[n].min_items = count(e);
+        } else if (keyword(key, "maxItems")) {
+            _nodes[n].max_items = count(e);
+        } else if (keyword(key, "items")) {
+            if (e.type() != type::k_document) {
+                throw std::runtime_error("items must be a schema");
+            }
+
+            // Compiling the child may grow _nodes, so the index is stored afterwards.
+            std::size_t items = compile(e.get_document().value, child_path(path, "$", 1));
+            _nodes[n].items = items;
+        } else if (keyword(key, "additionalProperties")) {
+            if (e.type() != type::k_bool) {
+                throw std::runtime_error("additionalProperties must be a boolean");
+            }
+
+            _nodes[n].additional = e.get_bool().value;
+        } else if (keyword(key, "properties")) {
+            if (e.type() != type::k_document) {
+                throw std::runtime_error("properties must be a document");
+            }
+
+            properties = e.get_document().value;
+            has_properties = true;
+        } else if (keyword(key, "required")) {
+            if (e.type() != type::k_array) {
+                throw std::runtime_error("required must be an array of strings");
+            }
+
+            for (auto&& name : e.get_array().value) {
+                if (name.type() != type::k_utf8) {
+                    throw std::runtime_error("required must be an array of strings");
+                }
+
+                types::b_utf8 value = name.get_utf8();
+                key_table::id_type id =
+                    _nodes[n].properties.intern(value.value.c_str(), value.value.length());
+
+                _nodes[n].required.push_back(id);
+                _nodes[n].required_paths.push_back(
+                    child_path(path, value.value.c_str(), value.value.length()));
+            }
+        } else if (!keyword(key, "title") && !keyword(key, "description")) {
+            throw std::runtime_error(std::string("unsupported schema keyword: ") + key.c_str());
+        }
+    }
+
+    if (has_properties) {
+        for (auto&& e : properties) {
+            if (e.type() != type::k_document) {
+                throw std::runtime_error("each property must be a schema");
+            }
+
+            string_or_literal key = e.key();
+            key_table::id_type id = _nodes[n].properties.intern(key.c_str(), key.length());
+
+            std::size_t child =
+                compile(e.get_document().value, child_path(path, key.c_str(), key.length()));
+
+            if (_nodes[n].children.size() <= id) {
+                _nodes[n].children.resize(id + 1, k_none);
+            }
+
+            _nodes[n].children[id] = child;
+        }
+    }
+
+    if (_nodes[n].properties.size() > k_max_properties) {
+        throw std::runtime_error("too many properties in one schema");
+    }
+
+    _nodes[n].children.resize(_nodes[n].properties.size(), k_none);
+
+    return n;
+}
+
+validation_result validator::validate(const document::view& doc) const {
+    validation_result result;
+    check_object(0, doc, result);
+    return result;
+}
+
+void validator::check(std::size_t n, const document::element& e, validation_result& result) const {
+    const node& s = _nodes[n];
+    type t = e.type();
+
+    if (s.types && !(s.types & type_bit(t))) {
+        result.add(s.path.c_str(), validation_error_code::k_type, t);
+        return;
+    }
+
+    if (is_number(t) && (s.has_minimum || s.has_maximum)) {
+        double v = number(e);
+
+        if (s.has_minimum && v < s.minimum) {
+            result.add(s.path.c_str(), validation_error_code::k_minimum, t);
+        }
+
+        if (s.has_maximum && v > s.maximum) {
+            result.add(s.path.c_str(), validation_error_code::k_maximum, t);
+        }
+    } else if (t == type::k_utf8 && (s.min_length || s.max_length != k_none)) {
+        types::b_utf8 value = e.get_utf8();
+        std::size_t len = code_points(value.value.c_str(), value.value.length());
+
+        if (len < s.min_length) {
+            result.add(s.path.c_str(), validation_error_code::k_min_length, t);
+        }
+
+        if (len > s.max_length) {
+            result.add(s.path.c_str(), validation_error_code::k_max_length, t);
+        }
+    } else if (t == type::k_document) {
+        check_object(n, e.get_document().value, result);
+    } else if (t == type::k_array) {
+        std::size_t items = 0;
+
+        for (auto&& item : e.get_array().value) {
+            items++;
+
+            if (s.items != k_none) {
+                check(s.items, item, result);
+            }
+        }
+
+        if (items < s.min_items) {
+            result.add(s.path.c_str(), validation_error_code::k_min_items, t);
+        }
+
+        if (items > s.max_items) {
+            result.add(s.path.c_str(), validation_error_code::k_max_items, t);
+        }
+    }
+}
+
+void validator::check_object(std::size_t n, const document::view& doc,
+                             validation_result& result) const {
+    const node& s = _nodes[n];
+
+    if (s.properties.size() == 0 && s.additional) {
+        return;
+    }
+
+    std::bitset<k_max_properties> seen;
+
+    for (auto&& e : doc) {
+        const char* key = e.key_data();
+        key_table::id_type id = s.properties.find(key, std::strlen(key));
+
+        if (id == key_table::k_npos) {
+            if (!s.additional) {
+                result.add(s.path.c_str(), validation_error_code::k_unexpected, e.type());
+            }
+
+            continue;
+        }
+
+        seen.set(id);
+
+        if (s.children[id] != k_none) {
+            check(s.children[id], e, result);
+        }
+    }
+
+    for (std::size_t i = 0; i < s.required.size(); i++) {
+        if (!seen.test(s.required[i])) {
+            result.add(s.required_paths[i].c_str(), validation_error_code::k_missing,
+                       type::k_eod);
+        }
+    }
+}
+
+}  // namespace bson
@@ -0,0 +1,144 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bson/document.hpp"
+#include "bson/key_table.hpp"
+#include "bson/types.hpp"
+
+namespace bson {
+
+enum class validation_error_code : std::uint8_t {
+    k_missing,
+    k_type,
+    /// A key not among the properties of an object that disallows additional ones. Reported
+    /// against the path of the object.
+    k_unexpected,
+    k_minimum,
+    k_maximum,
+    k_min_length,
+    k_max_length,
+    k_min_items,
+    k_max_items,
+};
+
+struct validation_error {
+    /// The dotted path of the offending field, with "$" standing for any array index. Owned by
+    /// the validator.
+    const char* path;
+    validation_error_code code;
+    /// The type found in the document, or k_eod for missing fields.
+    bson::type actual;
+};
+
+/// The outcome of validating a document. Keeps the first few errors inline, so that validation
+/// never allocates.
+class validation_result {
+   public:
+    static constexpr std::size_t k_max_errors = 8;
+
+    validation_result() : _count(0), _truncated(false) {}
+
+    explicit operator bool() const { return _count == 0; }
+
+    std::size_t size() const { return _count; }
+    const validation_error& operator[](std::size_t i) const { return _errors[i]; }
+
+    /// Whether there were more errors than could be kept.
+    bool truncated() const { return _truncated; }
+
+    void add(const char* path, validation_error_code code, bson::type actual) {
+        if (_count == k_max_errors) {
+            _truncated = true;
+            return;
+        }
+
+        _errors[_count++] = validation_error{path, code, actual};
+    }
+
+   private:
+    validation_error _errors[k_max_errors];
+    std::size_t _count;
+    bool _truncated;
+};
+
+/// Checks documents against a schema before they are written.
+///
+/// The schema is given in the $jsonSchema dialect the server understands, limited to the
+/// keywords bsonType (a name or a list of names, "number" included), required, properties,
+/// additionalProperties (as a boolean), minimum, maximum, minLength, maxLength, minItems,
+/// maxItems and items (as a single schema). It is compiled once into a tree of nodes holding
+/// interned property keys, so that checking a document is a single pass over its elements with
+/// one hash lookup per key and no allocation.
+class LIBMONGOCXX_EXPORT validator {
+   public:
+    /// The most properties a single object schema may declare, required ones included.
+    static constexpr std::size_t k_max_properties = 256;
+
+    /// Throws std::runtime_error if the schema uses anything outside the supported keywords.
+    explicit validator(const document::view& schema);
+
+    validator(validator&& rhs);
+    validator& operator=(validator&& rhs);
+    ~validator();
+
+    validation_result validate(const document::view& doc) const;
+
+   private:
+    static constexpr std::size_t k_none = static_cast<std::size_t>(-1);
+
+    struct node {
+        std::string path;
+        /// One bit per accepted type, see type_bit(). Zero accepts anything.
+        std::uint32_t types = 0;
+
+        bool has_minimum = false;
+        bool has_maximum = false;
+        double minimum = 0;
+        double maximum = 0;
+
+        std::size_t min_length = 0;
+        std::size_t max_length = k_none;
+        std::size_t min_items = 0;
+        std::size_t max_items = k_none;
+
+        std::size_t items = k_none;
+
+        key_table properties;
+        /// The schema node of each interned property, or k_none for required keys without one.
+        std::vector<std::size_t> children;
+        std::vector<key_table::id_type> required;
+        std::vector<std::string> required_paths;
+        bool additional = true;
+    };
+
+    std::size_t compile(const document::view& schema, const std::string& path);
+
+    void check(std::size_t n, const document::element& e, validation_result& result) const;
+    void check_object(std::size_t n, const document::view& doc, validation_result& result) const;
+
+    std::vector<node> _nodes;
+};
+
+}  // namespace bson
+
+#include "driver/config/postlude.hpp"
@@ -0,0 +1,103 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+
+#include "driver/base/async_collection.hpp"
+#include "driver/base/collection.hpp"
+#include "driver/base/database.hpp"
+#include "driver/base/private/async_cursor.hpp"
+#include "driver/base/private/executor.hpp"
+
+namespace mongo {
+namespace driver {
+
+async_collection::async_collection(executor::impl* executor, const std::string& database_name,
+                                   const std::string& collection_name)
+    : _executor(executor), _database_name(database_name), _collection_name(collection_name) {}
+
+template <typename T, typename F>
+std::future<T> async_collection::submit(cancellation token, F operation) {
+    // std::function needs copyable targets, so the promise is shared between run and fail.
+    auto promise = std::make_shared<std::promise<T>>();
+    std::future<T> future = promise->get_future();
+
+    executor::impl::task t;
+    t.cancelled = std::move(token._flag);
+    t.fail = [promise](std::exception_ptr error) { promise->set_exception(error); };
+    // Copies the names, as the async_collection may be gone by the time the operation runs.
+    std::string database_name = _database_name;
+    std::string collection_name = _collection_name;
+
+    t.run = [promise, operation, database_name, collection_name](client& c) {
+        try {
+            database db = c[database_name];
+            collection coll = db[collection_name];
+            promise->set_value(operation(coll));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    };
+
+    _executor->push(std::move(t));
+
+    return future;
+}
+
+std::future<std::vector<bson::document::value>> async_collection::find_async(
+    const model::find& model, cancellation token) {
+    return submit<std::vector<bson::document::value>>(std::move(token), [model](collection& c) {
+        std::vector<bson::document::value> documents;
+
+        for (auto&& doc : c.find(model)) {
+            documents.emplace_back(doc);
+        }
+
+        return documents;
+    });
+}
+
+async_cursor async_collection::find_cursor(const model::find& model) {
+    return async_cursor{
+        std::make_shared<async_cursor::impl>(_executor, _database_name, _collection_name, model)};
+}
+
+std::future<result::insert_one> async_collection::insert_one_async(const model::insert_one& model,
+                                                                   cancellation token) {
+    return submit<result::insert_one>(std::move(token),
+                                      [model](collection& c) { return c.insert_one(model); });
+}
+
+std::future<result::bulk_write> async_collection::bulk_write_async(model::bulk_write model,
+                                                                   cancellation token) {
+    auto shared = std::make_shared<model::bulk_write>(std::move(model));
+
+    return submit<result::bulk_write>(std::move(token),
+                                      [shared](collection& c) { return c.bulk_write(*shared); });
+}
+
+std::future<std::int64_t> async_collection::count_async(const model::count& model,
+                                                        cancellation token) {
+    return submit<std::int64_t>(std::move(token),
+                                [model](collection& c) { return c.count(model); });
+}
+
+std::future<optional<bson::document::value>> async_collection::find_one_and_update_async(
+    const model::find_one_and_update& model, cancellation token) {
+    return submit<optional<bson::document::value>>(
+        std::move(token), [model](collection& c) { return c.find_one_and_update(model); });
+}
+
+}  // namespace driver
+}  // namespace mongo
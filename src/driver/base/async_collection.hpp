@@ -0,0 +1,83 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "bson/document.hpp"
+#include "driver/base/async_cursor.hpp"
+#include "driver/base/executor.hpp"
+#include "driver/model/bulk_write.hpp"
+#include "driver/model/count.hpp"
+#include "driver/model/find.hpp"
+#include "driver/model/find_one_and_update.hpp"
+#include "driver/model/insert_one.hpp"
+#include "driver/result/bulk_write.hpp"
+#include "driver/result/insert_one.hpp"
+#include "driver/util/optional.hpp"
+
+namespace mongo {
+namespace driver {
+
+/// The operations of a collection, run on an executor's workers instead of the calling thread.
+/// Each returns a future right away, failing it with std::runtime_error if the operation fails, is
+/// cancelled, or is refused by a full queue. Documents referred to by a model must stay alive
+/// until its future is ready.
+class LIBMONGOCXX_EXPORT async_collection {
+
+    friend class executor;
+
+   public:
+    /// Reads every matching document, as a find cursor is only usable on the worker's thread.
+    std::future<std::vector<bson::document::value>> find_async(
+        const model::find& model = model::find{}, cancellation token = cancellation::none());
+
+    /// Opens a cursor over the matching documents, fetching them a batch at a time as they are
+    /// asked for. The query is only sent by the first call to next().
+    async_cursor find_cursor(const model::find& model = model::find{});
+
+    std::future<result::insert_one> insert_one_async(const model::insert_one& model,
+                                                     cancellation token = cancellation::none());
+
+    std::future<result::bulk_write> bulk_write_async(model::bulk_write model,
+                                                     cancellation token = cancellation::none());
+
+    std::future<std::int64_t> count_async(const model::count& model = model::count{},
+                                          cancellation token = cancellation::none());
+
+    std::future<optional<bson::document::value>> find_one_and_update_async(
+        const model::find_one_and_update& model, cancellation token = cancellation::none());
+
+   private:
+    async_collection(executor::impl* executor, const std::string& database_name,
+                     const std::string& collection_name);
+
+    template <typename T, typename F>
+    std::future<T> submit(cancellation token, F operation);
+
+    executor::impl* _executor;
+    std::string _database_name;
+    std::string _collection_name;
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
@@ -0,0 +1,74 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+
+#include "driver/base/async_cursor.hpp"
+#include "driver/base/private/async_cursor.hpp"
+#include "driver/base/private/executor.hpp"
+
+namespace mongo {
+namespace driver {
+
+async_cursor::async_cursor(std::shared_ptr<impl> impl) : _impl(std::move(impl)) {}
+
+async_cursor::async_cursor(async_cursor&&) = default;
+async_cursor& async_cursor::operator=(async_cursor&&) = default;
+async_cursor::~async_cursor() = default;
+
+std::future<optional<bson::document::view>> async_cursor::next() {
+    std::promise<optional<bson::document::view>> ready;
+
+    // Documents already fetched are served straight away, without a trip through the executor.
+    if (_impl->current && _impl->position < _impl->current->size()) {
+        ready.set_value((*_impl->current)[_impl->position++]);
+        return ready.get_future();
+    }
+
+    if (_impl->done) {
+        ready.set_value(nullopt);
+        return ready.get_future();
+    }
+
+    auto promise = std::make_shared<std::promise<optional<bson::document::view>>>();
+    std::future<optional<bson::document::view>> future = promise->get_future();
+    std::shared_ptr<impl> cursor = _impl;
+
+    executor::impl::task t;
+    t.fail = [promise](std::exception_ptr error) { promise->set_exception(error); };
+    t.run = [promise, cursor](client& c) {
+        try {
+            cursor->fetch(c);
+
+            if (cursor->done) {
+                promise->set_value(nullopt);
+            } else {
+                promise->set_value((*cursor->current)[cursor->position++]);
+            }
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    };
+
+    if (_impl->open) {
+        _impl->workers->push_to(_impl->worker, std::move(t));
+    } else {
+        _impl->workers->push(std::move(t));
+    }
+
+    return future;
+}
+
+}  // namespace driver
+}  // namespace mongo
@@ -0,0 +1,66 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <future>
+#include <memory>
+
+#include "bson/document.hpp"
+#include "driver/util/optional.hpp"
+
+namespace mongo {
+namespace driver {
+
+class async_collection;
+
+/// A cursor whose batches are fetched on an executor's workers, so that the thread consuming it
+/// never blocks on the network and can interleave many cursors, polling or waiting on each
+/// future in turn. Documents of the current batch are handed out with futures that are already
+/// ready; only the call that runs out of a batch waits for a worker to fetch the next one.
+///
+/// The query runs on the client of the worker that opened it, and every later fetch goes to that
+/// same worker. The cursor holds no client of its own, so any number of them can share an
+/// executor.
+///
+/// Documents are copied once into their batch, and a view stays valid until the next call to
+/// next(). The executor must outlive the cursor.
+class LIBMONGOCXX_EXPORT async_cursor {
+
+    friend class async_collection;
+
+    class impl;
+
+   public:
+    /// Fetches the next document, or nothing at the end of the results. Only one call may be
+    /// outstanding at a time: wait for the previous future before calling again.
+    std::future<optional<bson::document::view>> next();
+
+    async_cursor(async_cursor&& rhs);
+    async_cursor& operator=(async_cursor&& rhs);
+    ~async_cursor();
+
+   private:
+    explicit async_cursor(std::shared_ptr<impl> impl);
+
+    // Shared with the operation in flight, which may outlive the cursor.
+    std::shared_ptr<impl> _impl;
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
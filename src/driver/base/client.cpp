@@ -33,6 +33,8 @@ client::client(const std::string& mongodb_uri)
 client::client(const options& options)
     : _impl(new impl{mongoc_client_new(options._mongodb_uri.c_str())}) {}
 
+client::client(std::unique_ptr<impl> impl) : _impl(std::move(impl)) {}
+
 void client::read_preference(class read_preference rp) { _impl->read_preference(std::move(rp)); }
 const class read_preference& client::read_preference() const { return _impl->read_preference(); }
 
@@ -47,5 +49,19 @@ class database client::operator[](const std::string& database_name) {
     return database(database_name);
 }
 
+result::warm_up client::warm_up(std::chrono::steady_clock::time_point deadline) {
+    result::warm_up result{false, 0, std::chrono::nanoseconds{0}, std::chrono::nanoseconds{0}};
+
+    if (std::chrono::steady_clock::now() >= deadline) {
+        return result;
+    }
+
+    result.discovery = _impl->ping();
+    result.connections = 1;
+    result.is_complete = std::chrono::steady_clock::now() <= deadline;
+
+    return result;
+}
+
 }  // namespace driver
 }  // namespace mongo
@@ -16,11 +16,13 @@
 
 #include "driver/config/prelude.hpp"
 
+#include <chrono>
 #include <memory>
 
 #include "driver/base/database.hpp"
 #include "driver/base/read_preference.hpp"
 #include "driver/base/write_concern.hpp"
+#include "driver/result/warm_up.hpp"
 
 namespace mongo {
 namespace driver {
@@ -36,6 +38,7 @@ class LIBMONGOCXX_EXPORT client {
 
     friend class database;
     friend class collection;
+    friend class client_pool;
 
    public:
     client();
@@ -51,11 +54,22 @@ class LIBMONGOCXX_EXPORT client {
     class database operator[](const std::string& database_name);
     class database database(const std::string& database_name);
 
+    /// Connects to the deployment and discovers its topology ahead of the first operation. Throws
+    /// std::runtime_error if the server can't be reached.
+    ///
+    /// A client keeps a single connection to each server, so unlike client_pool::warm_up there is
+    /// no number of connections to ask for. Nothing is attempted once the deadline has passed,
+    /// but the round trip itself is bounded by the URI's serverSelectionTimeoutMS and
+    /// socketTimeoutMS rather than by the deadline, and is_complete is false if it overran.
+    result::warm_up warm_up(std::chrono::steady_clock::time_point deadline);
+
     client(client&& rhs);
     client& operator=(client&& rhs);
     ~client();
 
    private:
+    explicit client(std::unique_ptr<impl> impl);
+
     std::unique_ptr<impl> _impl;
 };
 
@@ -0,0 +1,121 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "private/preamble.hpp"
+
+#include "driver/base/client_pool.hpp"
+#include "driver/base/options.hpp"
+#include "driver/base/private/client.hpp"
+#include "driver/base/private/client_pool.hpp"
+
+namespace mongo {
+namespace driver {
+
+client_pool::client_pool(client_pool&&) = default;
+client_pool& client_pool::operator=(client_pool&&) = default;
+client_pool::~client_pool() = default;
+
+client_pool::client_pool() : _impl(new impl{"mongodb://localhost:27017"}) {}
+
+client_pool::client_pool(const std::string& mongodb_uri) : _impl(new impl{mongodb_uri}) {}
+
+client_pool::client_pool(const options& options) : _impl(new impl{options._mongodb_uri}) {}
+
+void client_pool::max_size(std::uint32_t max_size) {
+    mongoc_client_pool_max_size(_impl->pool_t, max_size);
+}
+
+void client_pool::min_size(std::uint32_t min_size) {
+    mongoc_client_pool_min_size(_impl->pool_t, min_size);
+}
+
+client client_pool::acquire() {
+    // Only time checkouts that actually have to wait, keeping the clock off the fast path.
+    mongoc_client_t* client_t = mongoc_client_pool_try_pop(_impl->pool_t);
+
+    if (!client_t) {
+        auto start = std::chrono::steady_clock::now();
+        client_t = mongoc_client_pool_pop(_impl->pool_t);
+        _impl->record_wait(std::chrono::steady_clock::now() - start);
+    }
+
+    _impl->acquired.fetch_add(1, std::memory_order_relaxed);
+
+    return client{std::unique_ptr<client::impl>{new client::impl{client_t, _impl->pool_t}}};
+}
+
+optional<client> client_pool::try_acquire() {
+    mongoc_client_t* client_t = mongoc_client_pool_try_pop(_impl->pool_t);
+
+    if (!client_t) {
+        _impl->refused.fetch_add(1, std::memory_order_relaxed);
+        return nullopt;
+    }
+
+    _impl->acquired.fetch_add(1, std::memory_order_relaxed);
+
+    return client{std::unique_ptr<client::impl>{new client::impl{client_t, _impl->pool_t}}};
+}
+
+client_pool_stats client_pool::stats() const {
+    client_pool_stats stats;
+
+    stats.acquired = _impl->acquired.load(std::memory_order_relaxed);
+    stats.waited = _impl->waited.load(std::memory_order_relaxed);
+    stats.refused = _impl->refused.load(std::memory_order_relaxed);
+    stats.total_wait = std::chrono::nanoseconds{_impl->total_wait.load(std::memory_order_relaxed)};
+    stats.max_wait = std::chrono::nanoseconds{_impl->max_wait.load(std::memory_order_relaxed)};
+
+    return stats;
+}
+
+result::warm_up client_pool::warm_up(std::size_t connections,
+                                     std::chrono::steady_clock::time_point deadline) {
+    result::warm_up result{false, 0, std::chrono::nanoseconds{0}, std::chrono::nanoseconds{0}};
+
+    // Every lease is held until the end, so that each round trip goes over a new connection.
+    // Clients are popped directly, as warming up is not load for stats() to count.
+    std::vector<client> leases;
+    leases.reserve(connections);
+
+    while (leases.size() < connections && std::chrono::steady_clock::now() < deadline) {
+        mongoc_client_t* client_t = mongoc_client_pool_try_pop(_impl->pool_t);
+
+        if (!client_t) {
+            break;
+        }
+
+        leases.push_back(
+            client{std::unique_ptr<client::impl>{new client::impl{client_t, _impl->pool_t}}});
+
+        std::chrono::nanoseconds elapsed = leases.back()._impl->ping();
+
+        if (leases.size() == 1) {
+            result.discovery = elapsed;
+        } else {
+            result.connect += elapsed;
+        }
+    }
+
+    result.connections = leases.size();
+    result.is_complete =
+        result.connections == connections && std::chrono::steady_clock::now() <= deadline;
+
+    return result;
+}
+
+}  // namespace driver
+}  // namespace mongo
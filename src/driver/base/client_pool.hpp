@@ -0,0 +1,92 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "driver/base/client.hpp"
+#include "driver/result/warm_up.hpp"
+#include "driver/util/optional.hpp"
+
+namespace mongo {
+namespace driver {
+
+class options;
+
+/// Checkout counters of a client_pool, for sizing it against real load.
+struct client_pool_stats {
+    /// Clients handed out by acquire() and try_acquire().
+    std::uint64_t acquired;
+    /// Calls to acquire() that found the pool exhausted and had to block.
+    std::uint64_t waited;
+    /// Calls to try_acquire() that found the pool exhausted.
+    std::uint64_t refused;
+    /// Time spent blocked in acquire(), in total and for the longest single wait.
+    std::chrono::nanoseconds total_wait;
+    std::chrono::nanoseconds max_wait;
+};
+
+/// A thread-safe pool of connections to a MongoDB deployment. Each thread acquires a client for as
+/// long as it needs one; destroying that client returns its connection to the pool, with its read
+/// preference and write concern reset. The pool must outlive every client acquired from it.
+class LIBMONGOCXX_EXPORT client_pool {
+
+    class impl;
+
+   public:
+    client_pool();
+    explicit client_pool(const std::string& mongodb_uri);
+    explicit client_pool(const options& options);
+
+    /// The most clients that may be out at once. acquire() blocks beyond that.
+    void max_size(std::uint32_t max_size);
+
+    /// The number of idle clients the pool keeps around rather than closing.
+    void min_size(std::uint32_t min_size);
+
+    /// Returns a client, waiting for one to be returned if the pool is exhausted.
+    client acquire();
+
+    /// Returns a client, or nothing if the pool is exhausted.
+    optional<client> try_acquire();
+
+    client_pool_stats stats() const;
+
+    /// Establishes up to connections connections, and discovers the topology, ahead of the first
+    /// operation. Starts no new round trip after the deadline, or once the pool is exhausted. A
+    /// round trip already under way is bounded by the URI's serverSelectionTimeoutMS and
+    /// socketTimeoutMS instead, as libmongoc takes no per-command timeout. The pool only keeps
+    /// min_size idle clients, so set that first to keep all of them open. Its leases are not
+    /// counted in stats(). Throws std::runtime_error if the server can't be reached.
+    result::warm_up warm_up(std::size_t connections,
+                            std::chrono::steady_clock::time_point deadline);
+
+    client_pool(client_pool&& rhs);
+    client_pool& operator=(client_pool&& rhs);
+    ~client_pool();
+
+   private:
+    std::unique_ptr<impl> _impl;
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
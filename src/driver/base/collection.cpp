@@ -15,6 +15,7 @@
 #include <cstdint>
 
 #include "bson/builder.hpp"
+#include "bson/literal.hpp"
 
 #include "driver/libmongoc.hpp"
 
@@ -146,26 +147,30 @@ cursor collection::aggregate(const model::aggregate& model) {
 
     scoped_bson_t pipeline(model.stages()._impl->view());
 
+    static constexpr auto k_no_options = bson::literal::doc();
+    static constexpr auto k_cursor_options =
+        bson::literal::doc(bson::literal::field("cursor", bson::literal::doc()));
+
     bson::builder::document b;
+    bson::document::view options_view = k_no_options.view();
 
     if (model.allow_disk_use()) {
         /* TODO */
     }
     if (model.use_cursor()) {
-        auto inner = b << "cursor" << open_doc;
-
         if (model.batch_size()) {
-            inner << "batchSize" << *model.batch_size();
+            b << "cursor" << open_doc << "batchSize" << *model.batch_size() << close_doc;
+            options_view = b.view();
+        } else {
+            options_view = k_cursor_options.view();
         }
-
-        inner << close_doc;
     }
 
     if (model.max_time_ms()) {
         /* TODO */
     }
 
-    scoped_bson_t options(b.view());
+    scoped_bson_t options(options_view);
 
     optional<priv::read_preference> read_prefs;
     const mongoc_read_prefs_t* rp_ptr;
@@ -12,28 +12,291 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
 
 #include "mongoc.h"
 #include "bson.h"
 
+#include "bson/util/endian.hpp"
 #include "driver/base/cursor.hpp"
 #include "driver/base/private/cursor.hpp"
+#include "driver/base/private/executor.hpp"
 
 namespace mongo {
 namespace driver {
 
+namespace {
+
+/// Shared by parallel_for_each and the tasks it submits, which may still be unwinding when it
+/// returns.
+struct for_each_state {
+    using batch_ptr = std::shared_ptr<const cursor::batch>;
+
+    explicit for_each_state(const std::function<void(const bson::document::view&)>* fn)
+        : fn(fn) {}
+
+    /// Runs fn over a batch, unless an earlier batch has already failed.
+    void process(const batch_ptr& batch) {
+        try {
+            if (!failed()) {
+                for (auto&& doc : *batch) {
+                    (*fn)(doc);
+                }
+            }
+        } catch (...) {
+            fail(std::current_exception(), 1);
+            return;
+        }
+
+        finish(1);
+    }
+
+    /// Records the first error, and retires count batches.
+    void fail(std::exception_ptr e, std::size_t count) {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        if (!error) {
+            error = e;
+        }
+
+        in_flight -= count;
+        done.notify_all();
+    }
+
+    void finish(std::size_t count) {
+        std::lock_guard<std::mutex> lock{mutex};
+        in_flight -= count;
+        done.notify_all();
+    }
+
+    bool failed() {
+        std::lock_guard<std::mutex> lock{mutex};
+        return static_cast<bool>(error);
+    }
+
+    /// Processes queued batches one after another, in order. At most one drain runs at a time.
+    void drain() {
+        for (;;) {
+            batch_ptr batch;
+
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+
+                if (queue.empty()) {
+                    draining = false;
+                    return;
+                }
+
+                batch = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            process(batch);
+        }
+    }
+
+    const std::function<void(const bson::document::view&)>* fn;
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t in_flight = 0;
+    std::exception_ptr error;
+
+    /// Batches waiting for the drain, in ordered mode.
+    std::deque<batch_ptr> queue;
+    bool draining = false;
+};
+
+}  // namespace
+
 cursor::cursor(cursor&&) = default;
 cursor& cursor::operator=(cursor&&) = default;
 cursor::~cursor() = default;
 
 cursor::cursor(void* cursor_ptr) : _impl(new impl{static_cast<mongoc_cursor_t*>(cursor_ptr)}) {}
 
+void cursor::prefetch(std::size_t max_batches, std::size_t max_bytes) {
+    if (_impl->started || _impl->prefetch) {
+        throw std::runtime_error("cursor: prefetch must be enabled before iterating");
+    }
+
+    _impl->prefetch.reset(new priv::prefetcher{_impl->cursor_t, max_batches, max_bytes});
+}
+
+void cursor::fill(batch* b, std::size_t max_documents, std::size_t max_bytes) {
+    bson::document::view doc;
+
+    // An empty batch would read as the end of the results, so every batch takes one document.
+    if (max_documents == 0) {
+        max_documents = 1;
+    }
+
+    if (max_bytes == 0) {
+        max_bytes = 1;
+    }
+
+    b->_bytes.clear();
+    b->_views.clear();
+
+    while (b->_views.size() < max_documents && b->_bytes.size() < max_bytes &&
+           _impl->next(&doc)) {
+        b->_bytes.insert(b->_bytes.end(), doc.get_buf(), doc.get_buf() + doc.get_len());
+        // Placeholders until the buffer has stopped moving.
+        b->_views.emplace_back();
+    }
+
+    std::size_t offset = 0;
+
+    for (auto&& view : b->_views) {
+        std::size_t len = static_cast<std::uint32_t>(bson::util::load_int32(&b->_bytes[offset]));
+        view = bson::document::view{&b->_bytes[offset], len};
+        offset += len;
+    }
+}
+
+const cursor::batch& cursor::next_batch(std::size_t max_documents, std::size_t max_bytes) {
+    fill(&_impl->batch, max_documents, max_bytes);
+    return _impl->batch;
+}
+
+std::shared_ptr<const cursor::batch> cursor::next_shared_batch(std::size_t max_documents,
+                                                               std::size_t max_bytes) {
+    std::shared_ptr<batch>& b = _impl->shared_batch;
+
+    // With no other owners left, nobody can take a new reference to the old batch either.
+    if (!b || b.use_count() > 1) {
+        b = std::make_shared<batch>();
+    }
+
+    fill(b.get(), max_documents, max_bytes);
+    return b;
+}
+
+void cursor::parallel_for_each(executor& workers,
+                               const std::function<void(const bson::document::view&)>& fn,
+                               for_each_mode mode, std::size_t max_in_flight) {
+    // A task of the same executor would wait on batches queued behind itself, and with every
+    // worker doing so nothing would run them. It processes them in place instead.
+    if (workers._impl->on_worker()) {
+        for (;;) {
+            std::shared_ptr<const batch> b = next_shared_batch();
+
+            if (b->empty()) {
+                return;
+            }
+
+            for (auto&& doc : *b) {
+                fn(doc);
+            }
+        }
+    }
+
+    auto state = std::make_shared<for_each_state>(&fn);
+
+    if (max_in_flight == 0) {
+        max_in_flight = 1;
+    }
+
+    try {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock{state->mutex};
+                state->done.wait(lock, [&] {
+                    return state->error || state->in_flight < max_in_flight;
+                });
+
+                if (state->error) {
+                    break;
+                }
+            }
+
+            std::shared_ptr<const batch> b = next_shared_batch();
+
+            if (b->empty()) {
+                break;
+            }
+
+            executor::impl::task t;
+
+            {
+                std::lock_guard<std::mutex> lock{state->mutex};
+                state->in_flight++;
+
+                if (mode == for_each_mode::k_ordered) {
+                    state->queue.push_back(std::move(b));
+
+                    // The running drain will get to it.
+                    if (state->draining) {
+                        continue;
+                    }
+
+                    state->draining = true;
+                }
+            }
+
+            if (mode == for_each_mode::k_unordered) {
+                t.run = [state, b](client&) { state->process(b); };
+                t.fail = [state](std::exception_ptr e) { state->fail(e, 1); };
+            } else {
+                t.run = [state](client&) { state->drain(); };
+                t.fail = [state](std::exception_ptr e) {
+                    std::size_t count;
+
+                    {
+                        std::lock_guard<std::mutex> lock{state->mutex};
+                        count = state->queue.size();
+                        state->queue.clear();
+                        state->draining = false;
+                    }
+
+                    state->fail(e, count);
+                };
+            }
+
+            workers._impl->push(std::move(t));
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock{state->mutex};
+
+        if (!state->error) {
+            state->error = std::current_exception();
+        }
+    }
+
+    std::unique_lock<std::mutex> lock{state->mutex};
+    state->done.wait(lock, [&] { return state->in_flight == 0; });
+
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+cursor::batch::const_iterator cursor::batch::begin() const { return _views.begin(); }
+
+cursor::batch::const_iterator cursor::batch::end() const { return _views.end(); }
+
+const bson::document::view& cursor::batch::operator[](std::size_t i) const { return _views[i]; }
+
+std::size_t cursor::batch::size() const { return _views.size(); }
+
+bool cursor::batch::empty() const { return _views.empty(); }
+
+const std::uint8_t* cursor::batch::data() const { return _bytes.data(); }
+
+std::size_t cursor::batch::length() const { return _bytes.size(); }
+
+std::shared_ptr<const bson::document::view> cursor::batch::pin(
+    const std::shared_ptr<const batch>& b, std::size_t i) {
+    return std::shared_ptr<const bson::document::view>{b, &b->_views[i]};
+}
+
 cursor::iterator& cursor::iterator::operator++() {
-    const bson_t* out;
-    if (mongoc_cursor_next(_cursor->_impl->cursor_t, &out)) {
-        _doc = bson::document::view(bson_get_data(out), out->len);
-    } else {
+    if (!_cursor->_impl->next(&_doc)) {
         _at_end = true;
     }
 
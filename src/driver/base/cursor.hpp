@@ -14,7 +14,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "driver/config/prelude.hpp"
 
@@ -24,6 +28,15 @@ namespace mongo {
 namespace driver {
 
 class collection;
+class executor;
+
+/// How cursor::parallel_for_each hands documents to its function.
+enum class for_each_mode : std::uint8_t {
+    /// One batch at a time, in result order. Only fetching overlaps with processing.
+    k_ordered,
+    /// Many batches at once, in any order, on as many workers as are free.
+    k_unordered,
+};
 
 class LIBMONGOCXX_EXPORT cursor {
 
@@ -32,11 +45,43 @@ class LIBMONGOCXX_EXPORT cursor {
     class impl;
 
    public:
+    class batch;
     class iterator;
 
     iterator begin();
     iterator end();
 
+    /// Reads up to max_documents documents, stopping early once they total max_bytes, and returns
+    /// them as one batch. An empty batch marks the end of the results. The batch is overwritten by
+    /// the next call, so its views stay valid until then. Batches and the iterator share one
+    /// position in the results. Limits of 0 are taken as 1, so a batch always holds at least one
+    /// document before the end.
+    const batch& next_batch(std::size_t max_documents = 1000, std::size_t max_bytes = 1 << 22);
+
+    /// Like next_batch, but the caller shares ownership of the batch instead of borrowing it, so
+    /// its documents stay valid for as long as the batch or any document pinned from it is held.
+    /// The cursor reuses a batch's buffer once nobody else holds it.
+    std::shared_ptr<const batch> next_shared_batch(std::size_t max_documents = 1000,
+                                                   std::size_t max_bytes = 1 << 22);
+
+    /// Calls fn for every remaining document on the workers of an executor, while this thread
+    /// keeps fetching. Documents are passed in shared batches, without being copied again, and at
+    /// most max_in_flight batches are fetched but not yet processed. Returns once every document
+    /// has been processed. If fn throws, no more batches are started, and the first exception is
+    /// rethrown once the running ones have finished. Called from a task running on the same
+    /// executor, it processes every batch on the calling thread instead of queueing them.
+    void parallel_for_each(executor& workers,
+                           const std::function<void(const bson::document::view&)>& fn,
+                           for_each_mode mode = for_each_mode::k_unordered,
+                           std::size_t max_in_flight = 4);
+
+    /// Fetches documents on a background thread, ahead of the iterator, keeping at most
+    /// max_batches batches totalling about max_bytes buffered. Documents are then copied once into
+    /// those batches, and a view stays valid until the iterator moves past its batch. The cursor's
+    /// client must not be used for anything else while it prefetches. Must be called before
+    /// iteration begins, or std::runtime_error is thrown.
+    void prefetch(std::size_t max_batches, std::size_t max_bytes);
+
     cursor(cursor&& rhs);
     cursor& operator=(cursor&& rhs);
     ~cursor();
@@ -44,9 +89,42 @@ class LIBMONGOCXX_EXPORT cursor {
    private:
     cursor(void* cursor_ptr);
 
+    void fill(batch* b, std::size_t max_documents, std::size_t max_bytes);
+
     std::unique_ptr<impl> _impl;
 };
 
+/// Documents read together by cursor::next_batch, stored back to back in one buffer.
+class LIBMONGOCXX_EXPORT cursor::batch {
+
+    friend class cursor;
+
+   public:
+    using const_iterator = std::vector<bson::document::view>::const_iterator;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    const bson::document::view& operator[](std::size_t i) const;
+
+    std::size_t size() const;
+    bool empty() const;
+
+    /// The documents as concatenated BSON, the layout of a reply's document section, ready to be
+    /// forwarded without walking them.
+    const std::uint8_t* data() const;
+    std::size_t length() const;
+
+    /// Shares ownership of document i of a shared batch. Holding the result keeps the whole batch
+    /// alive, and costs one reference count increment rather than a copy of the document.
+    static std::shared_ptr<const bson::document::view> pin(const std::shared_ptr<const batch>& b,
+                                                           std::size_t i);
+
+   private:
+    std::vector<std::uint8_t> _bytes;
+    std::vector<bson::document::view> _views;
+};
+
 class cursor::iterator
     : public std::iterator<std::forward_iterator_tag, const bson::document::view&, std::ptrdiff_t,
                            const bson::document::view*, const bson::document::view&> {
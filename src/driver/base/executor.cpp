@@ -0,0 +1,79 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+
+#include "driver/base/async_collection.hpp"
+#include "driver/base/executor.hpp"
+#include "driver/base/private/executor.hpp"
+
+namespace mongo {
+namespace driver {
+
+cancellation::cancellation() : _flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+cancellation::cancellation(std::shared_ptr<std::atomic<bool>> flag) : _flag(std::move(flag)) {}
+
+cancellation cancellation::none() { return cancellation{nullptr}; }
+
+void cancellation::cancel() {
+    if (_flag) {
+        _flag->store(true, std::memory_order_release);
+    }
+}
+
+bool cancellation::is_cancelled() const {
+    return _flag && _flag->load(std::memory_order_acquire);
+}
+
+executor::executor(client_pool& pool, std::size_t threads, std::size_t queue_capacity,
+                   queue_full_policy policy)
+    : _impl(new impl{pool, threads, queue_capacity, policy}) {}
+
+executor::executor(executor&&) = default;
+executor& executor::operator=(executor&&) = default;
+executor::~executor() = default;
+
+async_collection executor::collection(const std::string& database_name,
+                                      const std::string& collection_name) {
+    return async_collection{_impl.get(), database_name, collection_name};
+}
+
+std::future<void> executor::run_async(std::function<void(client&)> operation,
+                                      cancellation token) {
+    // std::function needs copyable targets, so the promise is shared between run and fail.
+    auto promise = std::make_shared<std::promise<void>>();
+    std::future<void> future = promise->get_future();
+
+    impl::task t;
+    t.cancelled = std::move(token._flag);
+    t.fail = [promise](std::exception_ptr error) { promise->set_exception(error); };
+    t.run = [promise, operation](client& c) {
+        try {
+            operation(c);
+            promise->set_value();
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    };
+
+    _impl->push(std::move(t));
+
+    return future;
+}
+
+std::size_t executor::pending() const { return _impl->pending(); }
+
+}  // namespace driver
+}  // namespace mongo
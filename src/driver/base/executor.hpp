@@ -0,0 +1,109 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+namespace mongo {
+namespace driver {
+
+class async_collection;
+class async_cursor;
+class client;
+class client_pool;
+class cursor;
+
+/// What executor does with an operation submitted while its queue is full.
+enum class queue_full_policy : std::uint8_t {
+    /// The submitting thread waits for room.
+    k_block,
+    /// The operation fails straight away, without waiting.
+    k_fail,
+};
+
+/// Calls off an operation that has not started yet, failing its future with std::runtime_error.
+/// Operations already running against the server are left to complete. Copies share one flag.
+class LIBMONGOCXX_EXPORT cancellation {
+
+    friend class async_collection;
+    friend class executor;
+
+   public:
+    cancellation();
+
+    /// A token that can never be cancelled, and costs nothing to create.
+    static cancellation none();
+
+    void cancel();
+    bool is_cancelled() const;
+
+   private:
+    explicit cancellation(std::shared_ptr<std::atomic<bool>> flag);
+
+    std::shared_ptr<std::atomic<bool>> _flag;
+};
+
+/// A fixed set of worker threads running driver operations in the background. Each worker holds
+/// one client from the pool for as long as it lives, leased when the executor is created. At most
+/// queue_capacity operations wait for a worker; what happens to the next one is decided by the
+/// queue_full_policy. Destroying the executor waits for running operations, and fails those still
+/// queued.
+class LIBMONGOCXX_EXPORT executor {
+
+    friend class async_collection;
+    friend class async_cursor;
+    friend class cursor;
+
+    class impl;
+
+   public:
+    /// Throws std::runtime_error if threads or queue_capacity is 0, or if the pool can't lease
+    /// threads clients straight away.
+    executor(client_pool& pool, std::size_t threads, std::size_t queue_capacity,
+             queue_full_policy policy = queue_full_policy::k_block);
+
+    /// Operations on the named collection, run by this executor, which must outlive it.
+    async_collection collection(const std::string& database_name,
+                                const std::string& collection_name);
+
+    /// Runs operation on a worker, with the worker's client, for work the collection operations
+    /// don't cover. The future fails with what operation throws, or with std::runtime_error if the
+    /// operation is cancelled or refused by a full queue.
+    std::future<void> run_async(std::function<void(client&)> operation,
+                                cancellation token = cancellation::none());
+
+    /// The number of operations waiting for a worker.
+    std::size_t pending() const;
+
+    executor(executor&& rhs);
+    executor& operator=(executor&& rhs);
+    ~executor();
+
+   private:
+    std::unique_ptr<impl> _impl;
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
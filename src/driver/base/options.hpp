@@ -24,6 +24,8 @@ namespace driver {
 /// The options class represents a set of options for the MongoDB driver client.
 class LIBMONGOCXX_EXPORT options {
     friend class client;
+    friend class client_pool;
+    friend class sharded_client_pool;
 
    public:
     options();
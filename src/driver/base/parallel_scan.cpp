@@ -0,0 +1,264 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bson/builder.hpp"
+#include "bson/literal.hpp"
+#include "bson/util/parallel.hpp"
+#include "driver/base/client.hpp"
+#include "driver/base/collection.hpp"
+#include "driver/base/cursor.hpp"
+#include "driver/base/database.hpp"
+#include "driver/base/parallel_scan.hpp"
+#include "driver/base/pipeline.hpp"
+#include "driver/base/private/parallel_scan.hpp"
+#include "driver/model/aggregate.hpp"
+
+namespace mongo {
+namespace driver {
+
+namespace {
+
+// More samples per partition make the partitions more even, at the cost of a larger sample.
+constexpr std::size_t k_samples_per_partition = 16;
+
+constexpr auto k_id = bson::literal::doc(bson::literal::field("_id", 1));
+
+bool same_bytes(const bson::document::view& a, const bson::document::view& b) {
+    return a.get_len() == b.get_len() && std::memcmp(a.get_buf(), b.get_buf(), a.get_len()) == 0;
+}
+
+}  // namespace
+
+parallel_scan::parallel_scan(client_pool& pool, const std::string& database_name,
+                             const std::string& collection_name, std::size_t partitions)
+    : _impl(new impl{pool, database_name, collection_name}) {
+    using namespace bson::builder::helpers;
+    using bson::types::b_document;
+
+    std::vector<bson::document::value> samples;
+
+    if (partitions > 1) {
+        client c = pool.acquire();
+        database db = c[database_name];
+        collection coll = db[collection_name];
+
+        pipeline stages;
+        stages.sample(static_cast<std::int32_t>(partitions * k_samples_per_partition))
+            .project(k_id.view())
+            .sort(k_id.view());
+
+        for (auto&& doc : coll.aggregate(model::aggregate{std::move(stages)})) {
+            samples.emplace_back(doc);
+        }
+    }
+
+    // Split the sorted sample into equal shares. $sample may return a document twice, so equal
+    // neighbouring splits are dropped rather than making empty partitions.
+    std::vector<bson::document::view> splits;
+
+    for (std::size_t j = 1; j < partitions; j++) {
+        std::size_t index = j * samples.size() / partitions;
+
+        if (index == 0 || (!splits.empty() && same_bytes(splits.back(), samples[index].view()))) {
+            continue;
+        }
+
+        splits.push_back(samples[index].view());
+    }
+
+    for (std::size_t i = 0; i <= splits.size(); i++) {
+        bson::builder::document modifiers;
+
+        if (i > 0) {
+            modifiers << "$min" << b_document{splits[i - 1]};
+        }
+
+        if (i < splits.size()) {
+            modifiers << "$max" << b_document{splits[i]};
+        }
+
+        // Servers require a hint with $min and $max, naming the index they bound.
+        modifiers << "$hint" << b_document{k_id.view()};
+
+        _impl->bounds.emplace_back(modifiers.view());
+    }
+}
+
+parallel_scan::parallel_scan(parallel_scan&&) = default;
+parallel_scan& parallel_scan::operator=(parallel_scan&&) = default;
+parallel_scan::~parallel_scan() = default;
+
+std::size_t parallel_scan::partitions() const { return _impl->bounds.size(); }
+
+model::find parallel_scan::partition(std::size_t i) const {
+    model::find find;
+
+    if (_impl->bounds.size() > 1) {
+        find.modifiers(_impl->bounds[i].view());
+    }
+
+    return find;
+}
+
+void parallel_scan::for_each(
+    const std::function<void(std::size_t, const bson::document::view&)>& fn) const {
+    bson::util::run_parallel(partitions(), [this, &fn](std::size_t i) {
+        client c = _impl->pool.acquire();
+        database db = c[_impl->database_name];
+        collection coll = db[_impl->collection_name];
+
+        for (auto&& doc : coll.find(partition(i))) {
+            fn(i, doc);
+        }
+    });
+}
+
+void parallel_scan::merge(const std::function<void(const bson::document::view&)>& fn,
+                          std::size_t max_batches) const {
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::condition_variable space;
+    std::deque<std::shared_ptr<const cursor::batch>> batches;
+    std::size_t running = partitions();
+    bool stopping = false;
+
+    if (max_batches == 0) {
+        max_batches = 1;
+    }
+
+    // Reads partition i into the queue, until it is exhausted or the merge is stopping.
+    auto read = [&](std::size_t i) {
+        client c = _impl->pool.acquire();
+        database db = c[_impl->database_name];
+        collection coll = db[_impl->collection_name];
+        cursor results = coll.find(partition(i));
+
+        for (;;) {
+            std::shared_ptr<const cursor::batch> batch = results.next_shared_batch();
+
+            if (batch->empty()) {
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock{mutex};
+            space.wait(lock, [&] { return stopping || batches.size() < max_batches; });
+
+            if (stopping) {
+                return;
+            }
+
+            batches.push_back(std::move(batch));
+            lock.unlock();
+
+            ready.notify_one();
+        }
+    };
+
+    // A failed reader stops the others too, as the merge is going to throw anyway.
+    auto finish = [&](bool failed) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            running--;
+            stopping = stopping || failed;
+        }
+
+        ready.notify_one();
+
+        if (failed) {
+            space.notify_all();
+        }
+    };
+
+    std::exception_ptr reader_error;
+
+    // The readers are started from a thread of their own, so that the calling thread can consume.
+    std::thread readers([&] {
+        try {
+            bson::util::run_parallel(partitions(), [&](std::size_t i) {
+                try {
+                    read(i);
+                } catch (...) {
+                    finish(true);
+                    throw;
+                }
+
+                finish(false);
+            });
+        } catch (...) {
+            reader_error = std::current_exception();
+
+            // Readers that could not be started never finish, so stop waiting for them.
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                running = 0;
+                stopping = true;
+            }
+
+            ready.notify_one();
+        }
+    });
+
+    std::exception_ptr consumer_error;
+
+    try {
+        for (;;) {
+            std::unique_lock<std::mutex> lock{mutex};
+            ready.wait(lock, [&] { return !batches.empty() || running == 0; });
+
+            if (batches.empty()) {
+                break;
+            }
+
+            std::shared_ptr<const cursor::batch> batch = std::move(batches.front());
+            batches.pop_front();
+            lock.unlock();
+
+            space.notify_one();
+
+            for (auto&& doc : *batch) {
+                fn(doc);
+            }
+        }
+    } catch (...) {
+        consumer_error = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+
+    space.notify_all();
+    readers.join();
+
+    if (consumer_error) {
+        std::rethrow_exception(consumer_error);
+    }
+
+    if (reader_error) {
+        std::rethrow_exception(reader_error);
+    }
+}
+
+}  // namespace driver
+}  // namespace mongo
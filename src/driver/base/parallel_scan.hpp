@@ -0,0 +1,75 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "bson/document.hpp"
+#include "driver/model/find.hpp"
+
+namespace mongo {
+namespace driver {
+
+class client_pool;
+
+/// Reads a whole collection over several connections at once. The collection is split into
+/// ranges of _id from a random sample of its _id values, and each range is read by a cursor of its
+/// own, on its own thread and pooled client. The ranges are index bounds on _id, so they follow
+/// the BSON comparison order across types and together cover every document exactly once.
+class LIBMONGOCXX_EXPORT parallel_scan {
+
+    class impl;
+
+   public:
+    /// Samples the collection to split it into up to partitions ranges. Fewer are made when the
+    /// collection is too small for that many. The pool must outlive the scan.
+    parallel_scan(client_pool& pool, const std::string& database_name,
+                  const std::string& collection_name, std::size_t partitions);
+
+    std::size_t partitions() const;
+
+    /// A find selecting partition i, for reading it some other way. It refers to bounds held by
+    /// the scan, and must not outlive it.
+    model::find partition(std::size_t i) const;
+
+    /// Reads every partition concurrently, calling fn(i, doc) for each document of partition i on
+    /// that partition's thread. If fn or a read throws, the first exception is rethrown once every
+    /// thread has finished.
+    void for_each(
+        const std::function<void(std::size_t, const bson::document::view&)>& fn) const;
+
+    /// Reads every partition concurrently, and calls fn for each document on the calling thread,
+    /// in no particular order. At most max_batches batches are buffered between the readers and
+    /// fn.
+    void merge(const std::function<void(const bson::document::view&)>& fn,
+               std::size_t max_batches = 16) const;
+
+    parallel_scan(parallel_scan&& rhs);
+    parallel_scan& operator=(parallel_scan&& rhs);
+    ~parallel_scan();
+
+   private:
+    std::unique_ptr<impl> _impl;
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
@@ -23,6 +23,8 @@ using namespace bson::types;
 
 pipeline::pipeline() : _impl(new impl{}) {}
 
+pipeline::pipeline(std::unique_ptr<impl> impl) : _impl(std::move(impl)) {}
+
 pipeline::pipeline(pipeline&&) = default;
 pipeline& pipeline::operator=(pipeline&&) = default;
 pipeline::~pipeline() = default;
@@ -44,8 +46,8 @@ pipeline& pipeline::match(bson::document::view criteria) {
     return *this;
 }
 
-pipeline& pipeline::out(std::string collection_name) {
-    _impl->sink() << open_doc << "$out" << collection_name << close_doc;
+pipeline& pipeline::out(bson::string_or_literal collection_name) {
+    _impl->sink() << open_doc << "$out" << std::move(collection_name) << close_doc;
     return *this;
 }
 
@@ -59,6 +61,11 @@ pipeline& pipeline::redact(bson::document::view restrictions) {
     return *this;
 }
 
+pipeline& pipeline::sample(std::int32_t size) {
+    _impl->sink() << open_doc << "$sample" << open_doc << "size" << size << close_doc << close_doc;
+    return *this;
+}
+
 pipeline& pipeline::skip(std::int32_t skip) {
     _impl->sink() << open_doc << "$skip" << skip << close_doc;
     return *this;
@@ -69,11 +76,13 @@ pipeline& pipeline::sort(bson::document::view sort) {
     return *this;
 }
 
-pipeline& pipeline::unwind(std::string field_name) {
-    _impl->sink() << open_doc << "$unwind" << field_name << close_doc;
+pipeline& pipeline::unwind(bson::string_or_literal field_name) {
+    _impl->sink() << open_doc << "$unwind" << std::move(field_name) << close_doc;
     return *this;
 }
 
+bson::document::view pipeline::view_array() const { return _impl->view(); }
+
 }  // namespace driver
 }  // namespace mongo
 
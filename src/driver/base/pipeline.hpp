@@ -22,6 +22,7 @@
 #include <memory>
 
 #include "bson/document.hpp"
+#include "bson/string_or_literal.hpp"
 
 namespace mongo {
 class collection;
@@ -29,10 +30,12 @@ class collection;
 namespace driver {
 
 class explain_result;
+class pipeline_template;
 
 class LIBMONGOCXX_EXPORT pipeline {
 
     friend class collection;
+    friend class pipeline_template;
 
     class impl;
 
@@ -46,14 +49,20 @@ class LIBMONGOCXX_EXPORT pipeline {
     pipeline& group(bson::document::view group);
     pipeline& limit(std::int32_t limit);
     pipeline& match(bson::document::view criteria);
-    pipeline& out(std::string collection_name);
+    pipeline& out(bson::string_or_literal collection_name);
     pipeline& project(bson::document::view projection);
     pipeline& redact(bson::document::view restrictions);
+    pipeline& sample(std::int32_t size);
     pipeline& skip(std::int32_t skip);
     pipeline& sort(bson::document::view sort);
-    pipeline& unwind(std::string field_name);
+    pipeline& unwind(bson::string_or_literal field_name);
+
+    /// The stages as a BSON array, valid until the pipeline is next modified.
+    bson::document::view view_array() const;
 
    private:
+    explicit pipeline(std::unique_ptr<impl> impl);
+
     std::unique_ptr<impl> _impl;
 };
 
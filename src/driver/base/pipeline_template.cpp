@@ -0,0 +1,158 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "bson/util/endian.hpp"
+#include "bson/util/raw.hpp"
+#include "driver/base/pipeline_template.hpp"
+#include "driver/base/private/pipeline.hpp"
+#include "driver/base/private/pipeline_template.hpp"
+
+namespace mongo {
+namespace driver {
+
+namespace {
+
+using bson::util::load_int32;
+using bson::util::store_int32;
+using bson::util::raw::element;
+
+const char k_param[] = "$param";
+
+/// Returns true if the document at doc is a placeholder, storing its name.
+bool placeholder(const std::uint8_t* doc, std::size_t len, std::string* name) {
+    element e;
+
+    if (!bson::util::raw::find(doc, len, k_param, sizeof(k_param) - 1, &e)) {
+        return false;
+    }
+
+    if (e.type != bson::type::k_utf8 || e.offset != 4 || e.end() + 1 != len) {
+        throw std::runtime_error("pipeline_template: a placeholder must be { $param: <string> }");
+    }
+
+    // Skip the string's length prefix and drop its trailing NUL.
+    name->assign(reinterpret_cast<const char*>(doc + e.value_offset + 4), e.value_len - 5);
+
+    return true;
+}
+
+}  // namespace
+
+void pipeline_template::impl::scan(std::size_t offset) {
+    std::size_t first = slots.size();
+    std::size_t len = static_cast<std::uint32_t>(load_int32(bytes.data() + offset));
+    std::size_t pos = 4;
+    element e;
+
+    while (bson::util::raw::read(bytes.data() + offset, len, pos, &e)) {
+        pos = e.end();
+
+        if (e.type != bson::type::k_document && e.type != bson::type::k_array) {
+            continue;
+        }
+
+        std::string name;
+
+        if (e.type == bson::type::k_document &&
+            placeholder(bytes.data() + offset + e.value_offset, e.value_len, &name)) {
+            slots.push_back(
+                slot{std::move(name), offset + e.offset, offset + e.value_offset, e.value_len});
+        } else {
+            scan(offset + e.value_offset);
+        }
+    }
+
+    if (slots.size() > first) {
+        containers.push_back(container{offset, first, slots.size()});
+    }
+}
+
+pipeline_template::pipeline_template(const pipeline& stages) : _impl(new impl{}) {
+    bson::document::view view = stages._impl->view();
+
+    _impl->bytes.assign(view.get_buf(), view.get_buf() + view.get_len());
+    _impl->scan(0);
+}
+
+pipeline_template::pipeline_template(pipeline_template&&) = default;
+pipeline_template& pipeline_template::operator=(pipeline_template&&) = default;
+pipeline_template::~pipeline_template() = default;
+
+std::size_t pipeline_template::slots() const { return _impl->slots.size(); }
+
+pipeline pipeline_template::bind(const bson::document::view& params) const {
+    const std::vector<impl::slot>& slots = _impl->slots;
+    const std::vector<std::uint8_t>& bytes = _impl->bytes;
+
+    // values[i] is bound to slot i, and shift[i] is how far slot i moves in the output.
+    std::vector<element> values(slots.size());
+    std::vector<std::ptrdiff_t> shift(slots.size() + 1);
+
+    for (std::size_t i = 0; i < slots.size(); i++) {
+        if (!bson::util::raw::find(params.get_buf(), params.get_len(), slots[i].name.data(),
+                                   slots[i].name.size(), &values[i])) {
+            throw std::runtime_error("pipeline_template: no value bound for " + slots[i].name);
+        }
+
+        shift[i + 1] = shift[i] + static_cast<std::ptrdiff_t>(values[i].value_len) -
+                       static_cast<std::ptrdiff_t>(slots[i].value_len);
+    }
+
+    std::size_t len = bytes.size() + shift.back();
+    std::uint8_t* buf = static_cast<std::uint8_t*>(std::malloc(len));
+
+    if (!buf) {
+        throw std::bad_alloc{};
+    }
+
+    std::uint8_t* out = buf;
+    std::size_t pos = 0;
+
+    for (std::size_t i = 0; i < slots.size(); i++) {
+        const impl::slot& s = slots[i];
+
+        std::memcpy(out, bytes.data() + pos, s.offset - pos);
+        out += s.offset - pos;
+
+        *out++ = static_cast<std::uint8_t>(values[i].type);
+
+        std::memcpy(out, bytes.data() + s.offset + 1, s.value_offset - s.offset - 1);
+        out += s.value_offset - s.offset - 1;
+
+        std::memcpy(out, params.get_buf() + values[i].value_offset, values[i].value_len);
+        out += values[i].value_len;
+
+        pos = s.value_offset + s.value_len;
+    }
+
+    std::memcpy(out, bytes.data() + pos, bytes.size() - pos);
+
+    for (const impl::container& c : _impl->containers) {
+        std::int32_t old_len = load_int32(bytes.data() + c.offset);
+
+        store_int32(buf + c.offset + shift[c.first],
+                    static_cast<std::int32_t>(old_len + shift[c.last] - shift[c.first]));
+    }
+
+    return pipeline{std::unique_ptr<pipeline::impl>{
+        new pipeline::impl{bson::document::value{buf, len}}}};
+}
+
+}  // namespace driver
+}  // namespace mongo
@@ -0,0 +1,66 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <memory>
+
+#include "bson/document.hpp"
+#include "driver/base/pipeline.hpp"
+
+namespace mongo {
+namespace driver {
+
+/// An aggregation pipeline that is serialized once and executed many times with different
+/// parameters. Placeholders are documents of the form { $param: "<name>" }, and may stand in for
+/// any value inside the stages:
+///
+///   pipeline p;
+///   p.match(criteria).limit(10);  // criteria is { status: { $param: "status" } }
+///
+///   pipeline_template shape{p};
+///   coll.aggregate(model::aggregate{shape.bind(params)});  // params is { status: "A" }
+///
+/// The offsets of every slot, and of every document enclosing one, are computed up front. bind()
+/// then copies the fixed bytes around each slot and patches the affected length prefixes, without
+/// running the builder.
+class LIBMONGOCXX_EXPORT pipeline_template {
+    class impl;
+
+   public:
+    /// Throws std::runtime_error if a placeholder is not of the form above.
+    explicit pipeline_template(const pipeline& stages);
+
+    pipeline_template(pipeline_template&&);
+    pipeline_template& operator=(pipeline_template&&);
+    ~pipeline_template();
+
+    /// The number of placeholders in the stages.
+    std::size_t slots() const;
+
+    /// Returns the stages with every placeholder replaced by the value of the same name in params.
+    /// Throws std::runtime_error if params lacks one of them.
+    pipeline bind(const bson::document::view& params) const;
+
+   private:
+    std::unique_ptr<impl> _impl;
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
@@ -0,0 +1,109 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "driver/base/async_cursor.hpp"
+#include "driver/base/client.hpp"
+#include "driver/base/collection.hpp"
+#include "driver/base/cursor.hpp"
+#include "driver/base/database.hpp"
+#include "driver/base/executor.hpp"
+#include "driver/base/private/executor.hpp"
+#include "driver/model/find.hpp"
+
+namespace mongo {
+namespace driver {
+
+class async_cursor::impl {
+   public:
+    /// The open query. It lives on the client of the worker that opened it, so it is only used,
+    /// and destroyed, on that worker.
+    struct query {
+        query(client& c, const std::string& database_name, const std::string& collection_name,
+              const model::find& model)
+            : db(c[database_name]), coll(db[collection_name]), results(coll.find(model)) {}
+
+        database db;
+        collection coll;
+        cursor results;
+    };
+
+    impl(executor::impl* workers, const std::string& database_name,
+         const std::string& collection_name, const model::find& model)
+        : workers(workers),
+          database_name(database_name),
+          collection_name(collection_name),
+          model(model) {}
+
+    ~impl() {
+        if (!open) {
+            return;
+        }
+
+        // The last owner may be any thread, so hand the query back to its worker to close it.
+        try {
+            std::shared_ptr<query> closing = std::move(open);
+
+            executor::impl::task t;
+            t.run = [closing](client&) {};
+            t.fail = [](std::exception_ptr) {};
+
+            // Only the task may hold the query, or it could still be closed here.
+            closing.reset();
+
+            workers->push_to(worker, std::move(t));
+        } catch (...) {
+        }
+    }
+
+    /// Reads the next batch into current. Runs on a worker, the first time on any of them and then
+    /// on the one whose client opened the query.
+    void fetch(client& c) {
+        if (!open) {
+            open = std::make_shared<query>(c, database_name, collection_name, model);
+            worker = workers->worker_of(c);
+        }
+
+        // Let go of the spent batch first, so that the cursor can refill its buffer in place.
+        current.reset();
+        current = open->results.next_shared_batch();
+        position = 0;
+        done = current->empty();
+    }
+
+    executor::impl* workers;
+
+    const std::string database_name;
+    const std::string collection_name;
+    const model::find model;
+
+    std::shared_ptr<query> open;
+    std::size_t worker = 0;
+
+    std::shared_ptr<const cursor::batch> current;
+    std::size_t position = 0;
+    bool done = false;
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
@@ -16,7 +16,12 @@
 
 #include "driver/config/prelude.hpp"
 
+#include <chrono>
+#include <stdexcept>
+
+#include "bson/literal.hpp"
 #include "driver/base/client.hpp"
+#include "driver/util/libbson.hpp"
 
 #include "mongoc.h"
 
@@ -30,13 +35,58 @@ class client::impl {
    public:
     impl(mongoc_client_t* client) : client_t(client) {}
 
-    ~impl() { mongoc_client_destroy(client_t); }
+    /// Leases a client from pool, returning it there on destruction.
+    impl(mongoc_client_t* client, mongoc_client_pool_t* pool) : client_t(client), _pool(pool) {}
+
+    ~impl() {
+        if (!_pool) {
+            mongoc_client_destroy(client_t);
+            return;
+        }
+
+        // The next lease must not inherit this one's settings, but keeps those of the pool's URI.
+        if (_pooled_read_prefs) {
+            mongoc_client_set_read_prefs(client_t, _pooled_read_prefs);
+            mongoc_read_prefs_destroy(_pooled_read_prefs);
+        }
+
+        if (_pooled_write_concern) {
+            mongoc_client_set_write_concern(client_t, _pooled_write_concern);
+            mongoc_write_concern_destroy(_pooled_write_concern);
+        }
+
+        mongoc_client_pool_push(_pool, client_t);
+    }
 
     mongoc_client_t* client_t;
 
+    /// Runs isMaster, which connects and discovers the topology if that hasn't happened yet, and
+    /// returns how long it took.
+    std::chrono::nanoseconds ping() {
+        static constexpr auto k_is_master =
+            bson::literal::doc(bson::literal::field("isMaster", 1));
+
+        bson::libbson::scoped_bson_t command{k_is_master.view()};
+        bson::libbson::scoped_bson_t reply;
+        bson_error_t error;
+
+        auto start = std::chrono::steady_clock::now();
+
+        if (!mongoc_client_command_simple(client_t, "admin", command.bson(), nullptr,
+                                          reply.bson(), &error)) {
+            throw std::runtime_error(error.message);
+        }
+
+        return std::chrono::steady_clock::now() - start;
+    }
+
     void read_preference(class read_preference rp) {
         priv::read_preference read_prefs{rp};
 
+        if (_pool && !_pooled_read_prefs) {
+            _pooled_read_prefs = mongoc_read_prefs_copy(mongoc_client_get_read_prefs(client_t));
+        }
+
         mongoc_client_set_read_prefs(client_t, read_prefs.get_read_preference());
 
         _read_preference = std::move(rp);
@@ -45,6 +95,11 @@ class client::impl {
     void write_concern(class write_concern wc) {
         priv::write_concern write_conc{wc};
 
+        if (_pool && !_pooled_write_concern) {
+            _pooled_write_concern =
+                mongoc_write_concern_copy(mongoc_client_get_write_concern(client_t));
+        }
+
         mongoc_client_set_write_concern(client_t, write_conc.get_write_concern());
 
         _write_concern = std::move(wc);
@@ -61,6 +116,10 @@ class client::impl {
     private:
     class read_preference _read_preference;
     class write_concern _write_concern;
+    mongoc_client_pool_t* _pool = nullptr;
+    // Copies of a leased client's settings from before they were first changed.
+    mongoc_read_prefs_t* _pooled_read_prefs = nullptr;
+    mongoc_write_concern_t* _pooled_write_concern = nullptr;
 };
 
 }  // namespace driver
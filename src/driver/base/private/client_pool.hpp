@@ -0,0 +1,70 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "driver/base/client_pool.hpp"
+
+#include "mongoc.h"
+
+namespace mongo {
+namespace driver {
+
+class client_pool::impl {
+   public:
+    explicit impl(const std::string& mongodb_uri) {
+        mongoc_uri_t* uri = mongoc_uri_new(mongodb_uri.c_str());
+
+        if (!uri) {
+            throw std::runtime_error("client_pool: invalid uri " + mongodb_uri);
+        }
+
+        pool_t = mongoc_client_pool_new(uri);
+        mongoc_uri_destroy(uri);
+    }
+
+    ~impl() { mongoc_client_pool_destroy(pool_t); }
+
+    void record_wait(std::chrono::nanoseconds wait) {
+        waited.fetch_add(1, std::memory_order_relaxed);
+        total_wait.fetch_add(wait.count(), std::memory_order_relaxed);
+
+        std::int64_t longest = max_wait.load(std::memory_order_relaxed);
+
+        while (wait.count() > longest &&
+               !max_wait.compare_exchange_weak(longest, wait.count(), std::memory_order_relaxed)) {
+        }
+    }
+
+    mongoc_client_pool_t* pool_t;
+
+    std::atomic<std::uint64_t> acquired{0};
+    std::atomic<std::uint64_t> waited{0};
+    std::atomic<std::uint64_t> refused{0};
+    std::atomic<std::int64_t> total_wait{0};
+    std::atomic<std::int64_t> max_wait{0};
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
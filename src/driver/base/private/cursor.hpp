@@ -16,7 +16,10 @@
 
 #include "driver/config/prelude.hpp"
 
+#include <memory>
+
 #include "driver/base/cursor.hpp"
+#include "driver/base/private/prefetcher.hpp"
 
 #include "mongoc.h"
 
@@ -25,8 +28,40 @@ namespace driver {
 
 class cursor::impl {
    public:
-    ~impl() { mongoc_cursor_destroy(cursor_t); }
+    explicit impl(mongoc_cursor_t* cursor) : cursor_t(cursor) {}
+
+    ~impl() {
+        // The prefetch thread must be stopped before the cursor it steps goes away.
+        prefetch.reset();
+        mongoc_cursor_destroy(cursor_t);
+    }
+
+    bool next(bson::document::view* out) {
+        started = true;
+
+        if (prefetch) {
+            return prefetch->next(out);
+        }
+
+        const bson_t* doc;
+
+        if (!mongoc_cursor_next(cursor_t, &doc)) {
+            return false;
+        }
+
+        *out = bson::document::view{bson_get_data(doc), doc->len};
+        return true;
+    }
+
     mongoc_cursor_t* cursor_t;
+    std::unique_ptr<priv::prefetcher> prefetch;
+    bool started = false;
+
+    /// Reused by every call to next_batch.
+    cursor::batch batch;
+
+    /// The last batch from next_shared_batch, reused once the caller lets go of it.
+    std::shared_ptr<cursor::batch> shared_batch;
 };
 
 }  // namespace driver
@@ -0,0 +1,230 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "driver/base/client.hpp"
+#include "driver/base/client_pool.hpp"
+#include "driver/base/executor.hpp"
+
+namespace mongo {
+namespace driver {
+
+class executor::impl {
+   public:
+    struct task {
+        /// Runs the operation on a worker's client, and completes its future.
+        std::function<void(client&)> run;
+        /// Completes the future with an error, for operations that never run.
+        std::function<void(std::exception_ptr)> fail;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    impl(client_pool& pool, std::size_t threads, std::size_t capacity, queue_full_policy policy)
+        : _capacity(capacity), _policy(policy), _pinned(threads) {
+        if (threads == 0 || capacity == 0) {
+            throw std::runtime_error("executor: threads and queue_capacity must be at least 1");
+        }
+
+        // Every client is leased here, so that a short pool fails the constructor instead of
+        // leaving workers blocked in acquire() for the destructor to wait on.
+        _clients.reserve(threads);
+
+        for (std::size_t i = 0; i < threads; i++) {
+            optional<client> c = pool.try_acquire();
+
+            if (!c) {
+                throw std::runtime_error("executor: the pool has fewer free clients than threads");
+            }
+
+            _clients.push_back(std::move(*c));
+        }
+
+        _workers.reserve(threads);
+
+        try {
+            for (std::size_t i = 0; i < threads; i++) {
+                _workers.emplace_back([this, i] { work(i); });
+            }
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    ~impl() { stop(); }
+
+    void push(task t) {
+        std::unique_lock<std::mutex> lock{_mutex};
+
+        if (_queue.size() >= _capacity && _policy == queue_full_policy::k_fail) {
+            lock.unlock();
+            t.fail(error("executor: queue is full"));
+            return;
+        }
+
+        _not_full.wait(lock, [this] { return _stopping || _queue.size() < _capacity; });
+
+        if (_stopping) {
+            lock.unlock();
+            t.fail(error("executor: shut down before the operation ran"));
+            return;
+        }
+
+        _queue.push_back(std::move(t));
+        lock.unlock();
+
+        _not_empty.notify_one();
+    }
+
+    /// Queues a task for one worker in particular, for state tied to that worker's client. Such
+    /// tasks go ahead of the shared queue and don't count against its capacity.
+    void push_to(std::size_t worker, task t) {
+        std::unique_lock<std::mutex> lock{_mutex};
+
+        if (_stopping) {
+            lock.unlock();
+            t.fail(error("executor: shut down before the operation ran"));
+            return;
+        }
+
+        _pinned[worker].push_back(std::move(t));
+        lock.unlock();
+
+        // Any worker may be the one waiting, so wake them all to let the right one through.
+        _not_empty.notify_all();
+    }
+
+    /// The worker running on c, which must be a client passed to a task.
+    std::size_t worker_of(const client& c) const {
+        return static_cast<std::size_t>(&c - _clients.data());
+    }
+
+    /// Whether the calling thread is one of this executor's workers.
+    bool on_worker() const { return current() == this; }
+
+    std::size_t pending() const {
+        std::lock_guard<std::mutex> lock{_mutex};
+        return _queue.size();
+    }
+
+   private:
+    static std::exception_ptr error(const char* what) {
+        return std::make_exception_ptr(std::runtime_error(what));
+    }
+
+    /// The executor whose worker is running on this thread, if any.
+    static const impl*& current() {
+        static thread_local const impl* running = nullptr;
+        return running;
+    }
+
+    /// Joins the workers, and fails whatever they left in the queue.
+    void stop() {
+        std::deque<task> abandoned;
+
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _stopping = true;
+            abandoned.swap(_queue);
+        }
+
+        _not_empty.notify_all();
+        _not_full.notify_all();
+
+        for (auto&& worker : _workers) {
+            worker.join();
+        }
+
+        for (auto&& t : abandoned) {
+            t.fail(error("executor: shut down before the operation ran"));
+        }
+    }
+
+    void work(std::size_t worker) {
+        std::deque<task>& pinned = _pinned[worker];
+        current() = this;
+
+        for (;;) {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _not_empty.wait(lock,
+                            [&] { return _stopping || !pinned.empty() || !_queue.empty(); });
+
+            if (_stopping) {
+                // Pinned tasks hold state of this worker's client, so they are let go of here.
+                std::deque<task> abandoned;
+                abandoned.swap(pinned);
+                lock.unlock();
+
+                for (auto&& t : abandoned) {
+                    t.fail(error("executor: shut down before the operation ran"));
+                }
+
+                return;
+            }
+
+            task t;
+
+            if (!pinned.empty()) {
+                t = std::move(pinned.front());
+                pinned.pop_front();
+                lock.unlock();
+            } else {
+                t = std::move(_queue.front());
+                _queue.pop_front();
+                lock.unlock();
+
+                _not_full.notify_one();
+            }
+
+            if (t.cancelled && t.cancelled->load(std::memory_order_acquire)) {
+                t.fail(error("executor: operation cancelled"));
+            } else {
+                t.run(_clients[worker]);
+            }
+        }
+    }
+
+    const std::size_t _capacity;
+    const queue_full_policy _policy;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _not_empty;
+    std::condition_variable _not_full;
+    std::deque<task> _queue;
+    std::vector<std::deque<task>> _pinned;
+    bool _stopping = false;
+
+    std::vector<client> _clients;
+    std::vector<std::thread> _workers;
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
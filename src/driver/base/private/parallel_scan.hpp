@@ -0,0 +1,46 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "bson/document.hpp"
+#include "driver/base/client_pool.hpp"
+#include "driver/base/parallel_scan.hpp"
+
+namespace mongo {
+namespace driver {
+
+class parallel_scan::impl {
+   public:
+    impl(client_pool& pool, const std::string& database_name, const std::string& collection_name)
+        : pool(pool), database_name(database_name), collection_name(collection_name) {}
+
+    client_pool& pool;
+    std::string database_name;
+    std::string collection_name;
+
+    /// The find modifiers bounding each partition, or an empty document when there is only one.
+    std::vector<bson::document::value> bounds;
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
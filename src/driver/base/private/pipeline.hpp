@@ -18,23 +18,34 @@
 
 #include "bson/builder.hpp"
 #include "driver/base/pipeline.hpp"
+#include "driver/util/optional.hpp"
 
 namespace mongo {
 namespace driver {
 
 class pipeline::impl {
    public:
+    impl() = default;
+
+    /// Adopts an already serialized stage array, as produced by pipeline_template::bind.
+    explicit impl(bson::document::value stages) : _stages(std::move(stages)) {}
 
     bson::builder::single_ctx sink() {
+        if (_stages) {
+            _builder << bson::builder::helpers::concat{_stages->view()};
+            _stages = nullopt;
+        }
+
         return _builder;
     }
 
     bson::document::view view() {
-        return _builder.view();
+        return _stages ? _stages->view() : _builder.view();
     }
 
    private:
     bson::builder::array _builder;
+    optional<bson::document::value> _stages;
 };
 
 }  // namespace driver
@@ -0,0 +1,59 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "driver/base/pipeline_template.hpp"
+
+namespace mongo {
+namespace driver {
+
+class pipeline_template::impl {
+   public:
+    /// A placeholder, located by the offsets of its element within bytes.
+    struct slot {
+        std::string name;
+        std::size_t offset;
+        std::size_t value_offset;
+        std::size_t value_len;
+    };
+
+    /// A document or array containing the slots [first, last), whose length prefix changes
+    /// whenever they are bound to values of a different size.
+    struct container {
+        std::size_t offset;
+        std::size_t first;
+        std::size_t last;
+    };
+
+    /// Records the slots within the document or array at offset in bytes, and every container
+    /// holding them.
+    void scan(std::size_t offset);
+
+    std::vector<std::uint8_t> bytes;
+    std::vector<slot> slots;
+    std::vector<container> containers;
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
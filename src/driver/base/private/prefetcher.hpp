@@ -0,0 +1,165 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "bson/document/arena.hpp"
+
+#include "mongoc.h"
+
+namespace mongo {
+namespace driver {
+namespace priv {
+
+/// Steps a mongoc cursor on a thread of its own, copying documents into batches of about
+/// max_bytes / max_batches bytes, and keeps up to max_batches of them ready for the consumer.
+/// The network round trips for later batches then overlap with the processing of earlier ones.
+class prefetcher {
+   public:
+    prefetcher(mongoc_cursor_t* cursor, std::size_t max_batches, std::size_t max_bytes)
+        : _cursor(cursor),
+          _max_batches(max_batches ? max_batches : 1),
+          _batch_bytes(max_bytes / _max_batches ? max_bytes / _max_batches : 1),
+          _current(_batch_bytes),
+          _thread([this] { run(); }) {}
+
+    ~prefetcher() {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _stopping = true;
+        }
+
+        _space.notify_one();
+        _thread.join();
+    }
+
+    /// Moves to the next document, returning false at the end of the results. The view stays valid
+    /// until the batch holding it is used up. Throws std::runtime_error if the cursor failed.
+    bool next(bson::document::view* out) {
+        while (_position == _current.size()) {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _ready.wait(lock, [this] { return _done || !_batches.empty(); });
+
+            if (_batches.empty()) {
+                if (_error) {
+                    std::rethrow_exception(_error);
+                }
+
+                return false;
+            }
+
+            _current = std::move(_batches.front());
+            _batches.pop_front();
+            _position = 0;
+
+            lock.unlock();
+            _space.notify_one();
+        }
+
+        *out = _current[_position++];
+        return true;
+    }
+
+   private:
+    void run() {
+        try {
+            fetch();
+        } catch (...) {
+            // Such as bad_alloc from a batch. The consumer gets it after the batches already
+            // queued, as it would a cursor error.
+            {
+                std::lock_guard<std::mutex> lock{_mutex};
+                _error = std::current_exception();
+                _done = true;
+            }
+
+            _ready.notify_one();
+        }
+    }
+
+    void fetch() {
+        bool more = true;
+
+        while (more) {
+            bson::document::arena batch{_batch_bytes};
+            const bson_t* doc;
+
+            while ((more = mongoc_cursor_next(_cursor, &doc))) {
+                batch.push_back(bson::document::view{bson_get_data(doc), doc->len});
+
+                if (batch.bytes() >= _batch_bytes) {
+                    break;
+                }
+            }
+
+            std::unique_lock<std::mutex> lock{_mutex};
+            _space.wait(lock, [this] { return _stopping || _batches.size() < _max_batches; });
+
+            if (_stopping) {
+                return;
+            }
+
+            if (!batch.empty()) {
+                _batches.push_back(std::move(batch));
+            }
+
+            if (!more) {
+                bson_error_t error;
+
+                if (mongoc_cursor_error(_cursor, &error)) {
+                    _error = std::make_exception_ptr(std::runtime_error(error.message));
+                }
+
+                _done = true;
+            }
+
+            lock.unlock();
+            _ready.notify_one();
+        }
+    }
+
+    mongoc_cursor_t* _cursor;
+    const std::size_t _max_batches;
+    const std::size_t _batch_bytes;
+
+    std::mutex _mutex;
+    std::condition_variable _ready;
+    std::condition_variable _space;
+    std::deque<bson::document::arena> _batches;
+    bool _done = false;
+    bool _stopping = false;
+    std::exception_ptr _error;
+
+    /// Only touched by the consumer.
+    bson::document::arena _current;
+    std::size_t _position = 0;
+
+    std::thread _thread;
+};
+
+}  // namespace priv
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
@@ -0,0 +1,113 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <atomic>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "driver/base/client_pool.hpp"
+#include "driver/base/sharded_client_pool.hpp"
+
+namespace mongo {
+namespace driver {
+
+class sharded_client_pool::impl {
+   public:
+    /// Every shard is a libmongoc pool with its own topology monitoring and connections, so the
+    /// default stays small whatever the number of cores.
+    static constexpr std::size_t k_default_shards = 4;
+
+    impl(const std::string& mongodb_uri, std::size_t count) {
+        if (count == 0) {
+            count = k_default_shards;
+        }
+
+        usable.assign(count, true);
+        shards.reserve(count);
+
+        for (std::size_t i = 0; i < count; i++) {
+            shards.emplace_back(mongodb_uri);
+        }
+    }
+
+    /// The shard the calling thread draws from.
+    std::size_t home() const {
+#if defined(__linux__)
+        int cpu = sched_getcpu();
+
+        if (cpu >= 0) {
+            return static_cast<std::size_t>(cpu) % shards.size();
+        }
+#endif
+        static thread_local std::size_t id =
+            std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+        return id % shards.size();
+    }
+
+    /// Tries every shard, starting from home.
+    optional<client> try_acquire(std::size_t home) {
+        for (std::size_t i = 0; i < shards.size(); i++) {
+            optional<client> c = shards[(home + i) % shards.size()].try_acquire();
+
+            if (c) {
+                if (i != 0) {
+                    stolen.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                return c;
+            }
+        }
+
+        return nullopt;
+    }
+
+    /// The shard to wait on when every shard is exhausted: home, unless its limit is zero.
+    std::size_t waiting_shard(std::size_t home) const {
+        for (std::size_t i = 0; i < shards.size(); i++) {
+            std::size_t shard = (home + i) % shards.size();
+
+            if (usable[shard]) {
+                return shard;
+            }
+        }
+
+        return home;
+    }
+
+    std::vector<client_pool> shards;
+
+    /// Whether each shard may hold any clients, which is false once max_size gave it a share of 0.
+    std::vector<bool> usable;
+
+    std::atomic<std::uint64_t> stolen{0};
+    std::atomic<std::uint64_t> refused{0};
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
@@ -0,0 +1,132 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "driver/base/options.hpp"
+#include "driver/base/sharded_client_pool.hpp"
+#include "driver/base/private/sharded_client_pool.hpp"
+
+namespace mongo {
+namespace driver {
+
+namespace {
+
+// Shard i's share of total, with the first total % shards shards taking one extra.
+std::uint32_t per_shard(std::uint32_t total, std::size_t shards, std::size_t i) {
+    return static_cast<std::uint32_t>(total / shards + (i < total % shards ? 1 : 0));
+}
+
+}  // namespace
+
+sharded_client_pool::sharded_client_pool(sharded_client_pool&&) = default;
+sharded_client_pool& sharded_client_pool::operator=(sharded_client_pool&&) = default;
+sharded_client_pool::~sharded_client_pool() = default;
+
+sharded_client_pool::sharded_client_pool(const std::string& mongodb_uri, std::size_t shards)
+    : _impl(new impl{mongodb_uri, shards}) {}
+
+sharded_client_pool::sharded_client_pool(const options& options, std::size_t shards)
+    : _impl(new impl{options._mongodb_uri, shards}) {}
+
+void sharded_client_pool::max_size(std::uint32_t max_size) {
+    std::size_t count = _impl->shards.size();
+
+    for (std::size_t i = 0; i < count; i++) {
+        std::uint32_t share = per_shard(max_size, count, i);
+
+        _impl->shards[i].max_size(share);
+        _impl->usable[i] = share > 0;
+    }
+}
+
+void sharded_client_pool::min_size(std::uint32_t min_size) {
+    std::size_t count = _impl->shards.size();
+
+    for (std::size_t i = 0; i < count; i++) {
+        _impl->shards[i].min_size(per_shard(min_size, count, i));
+    }
+}
+
+client sharded_client_pool::acquire() {
+    std::size_t home = _impl->home();
+    optional<client> c = _impl->try_acquire(home);
+
+    if (c) {
+        return std::move(*c);
+    }
+
+    return _impl->shards[_impl->waiting_shard(home)].acquire();
+}
+
+optional<client> sharded_client_pool::try_acquire() {
+    optional<client> c = _impl->try_acquire(_impl->home());
+
+    if (!c) {
+        _impl->refused.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return c;
+}
+
+std::size_t sharded_client_pool::shards() const { return _impl->shards.size(); }
+
+client_pool_stats sharded_client_pool::stats() const {
+    client_pool_stats total{};
+
+    for (auto&& shard : _impl->shards) {
+        client_pool_stats stats = shard.stats();
+
+        total.acquired += stats.acquired;
+        total.waited += stats.waited;
+        total.total_wait += stats.total_wait;
+
+        if (stats.max_wait > total.max_wait) {
+            total.max_wait = stats.max_wait;
+        }
+    }
+
+    total.refused = _impl->refused.load(std::memory_order_relaxed);
+
+    return total;
+}
+
+std::uint64_t sharded_client_pool::stolen() const {
+    return _impl->stolen.load(std::memory_order_relaxed);
+}
+
+result::warm_up sharded_client_pool::warm_up(std::size_t connections,
+                                             std::chrono::steady_clock::time_point deadline) {
+    result::warm_up total{true, 0, std::chrono::nanoseconds{0}, std::chrono::nanoseconds{0}};
+    std::size_t count = _impl->shards.size();
+
+    for (std::size_t i = 0; i < count; i++) {
+        // Split the same way as the limits, so no shard is asked for more than it may hold.
+        std::size_t share = connections / count + (i < connections % count ? 1 : 0);
+
+        if (share == 0) {
+            continue;
+        }
+
+        result::warm_up shard = _impl->shards[i].warm_up(share, deadline);
+
+        total.is_complete = total.is_complete && shard.is_complete;
+        total.connections += shard.connections;
+        total.discovery += shard.discovery;
+        total.connect += shard.connect;
+    }
+
+    return total;
+}
+
+}  // namespace driver
+}  // namespace mongo
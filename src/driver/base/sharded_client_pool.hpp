@@ -0,0 +1,83 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "driver/base/client.hpp"
+#include "driver/base/client_pool.hpp"
+#include "driver/result/warm_up.hpp"
+#include "driver/util/optional.hpp"
+
+namespace mongo {
+namespace driver {
+
+class options;
+
+/// A client_pool split into independent shards, so that threads checking out clients concurrently
+/// rarely meet on the same lock. Each thread draws from the shard of the CPU it runs on, and only
+/// when that shard is exhausted probes the others in turn, stealing an idle client from the first
+/// that has one. Clients return to the shard they came from. Hands out the same clients as
+/// client_pool, and the pool must likewise outlive them.
+class LIBMONGOCXX_EXPORT sharded_client_pool {
+
+    class impl;
+
+   public:
+    /// Creates a small fixed number of shards when shards is 0.
+    explicit sharded_client_pool(const std::string& mongodb_uri, std::size_t shards = 0);
+    explicit sharded_client_pool(const options& options, std::size_t shards = 0);
+
+    /// Limits are split exactly over the shards, the first ones taking the remainder. When a limit
+    /// is smaller than the number of shards, the last shards get none.
+    void max_size(std::uint32_t max_size);
+    void min_size(std::uint32_t min_size);
+
+    client acquire();
+    optional<client> try_acquire();
+
+    std::size_t shards() const;
+
+    /// Checkouts summed over every shard. refused only counts calls to try_acquire() that found
+    /// every shard exhausted.
+    client_pool_stats stats() const;
+
+    /// The number of checkouts served by a shard other than the caller's own.
+    std::uint64_t stolen() const;
+
+    /// Warms up every shard in turn, spreading connections evenly over them. Each shard discovers
+    /// the topology on its own, and discovery reports the sum. The deadline is honoured as by
+    /// client_pool::warm_up.
+    result::warm_up warm_up(std::size_t connections,
+                            std::chrono::steady_clock::time_point deadline);
+
+    sharded_client_pool(sharded_client_pool&& rhs);
+    sharded_client_pool& operator=(sharded_client_pool&& rhs);
+    ~sharded_client_pool();
+
+   private:
+    std::unique_ptr<impl> _impl;
+};
+
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
@@ -0,0 +1,41 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "driver/config/prelude.hpp"
+
+#include <chrono>
+#include <cstddef>
+
+namespace mongo {
+namespace driver {
+namespace result {
+
+struct LIBMONGOCXX_EXPORT warm_up {
+    /// Whether every requested connection was established before the deadline.
+    bool is_complete;
+    /// The number of connections that completed a round trip to the server.
+    std::size_t connections;
+    /// The first round trip, which connects, handshakes and discovers the topology.
+    std::chrono::nanoseconds discovery;
+    /// The round trips that brought up the remaining connections, once the topology was known.
+    std::chrono::nanoseconds connect;
+};
+
+}  // namespace result
+}  // namespace driver
+}  // namespace mongo
+
+#include "driver/config/postlude.hpp"
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <utility>
+
 namespace mongo {
 namespace driver {
 namespace util {
@@ -25,7 +27,8 @@ class is_iterable {
     typedef Yes No[2];
 
     template <typename C>
-    static auto Test(void*) -> decltype(size_t{std::declval<C const>().begin()}, Yes{});
+    static auto Test(void*)
+        -> decltype(std::declval<C const>().begin(), std::declval<C const>().end(), Yes{});
 
     template <typename>
     static No& Test(...);
@@ -18,12 +18,19 @@
 
 #include "bson/document.hpp"
 
+#include "driver/base/async_collection.hpp"
+#include "driver/base/async_cursor.hpp"
 #include "driver/base/client.hpp"
+#include "driver/base/client_pool.hpp"
 #include "driver/base/collection.hpp"
 #include "driver/base/cursor.hpp"
 #include "driver/base/database.hpp"
+#include "driver/base/executor.hpp"
 #include "driver/base/options.hpp"
+#include "driver/base/parallel_scan.hpp"
 #include "driver/base/pipeline.hpp"
+#include "driver/base/pipeline_template.hpp"
+#include "driver/base/sharded_client_pool.hpp"
 
 #include "driver/model/aggregate.hpp"
 #include "driver/model/delete_many.hpp"
@@ -0,0 +1,47 @@
+#include "catch.hpp"
+
+#include <cstring>
+
+#include "bson/builder.hpp"
+#include "bson/document/arena.hpp"
+
+using namespace bson;
+
+TEST_CASE("arena keeps copies of documents", "[bson::document::arena]") {
+    document::arena arena{64};
+
+    for (std::int32_t i = 0; i < 10; i++) {
+        builder::document b;
+        b << "i" << i << "padding"
+          << "some bytes to spill over a chunk";
+
+        document::view copy = arena.push_back(b.view());
+
+        REQUIRE(copy.get_buf() != b.view().get_buf());
+        REQUIRE(std::memcmp(copy.get_buf(), b.view().get_buf(), copy.get_len()) == 0);
+    }
+
+    REQUIRE(arena.size() == 10);
+
+    std::int32_t expected = 0;
+
+    for (auto&& doc : arena) {
+        REQUIRE(doc["i"].get_int32().value == expected++);
+    }
+
+    SECTION("views survive sharing") {
+        document::view first = arena[0];
+        std::shared_ptr<const document::arena> shared = arena.share();
+
+        REQUIRE(arena.empty());
+        REQUIRE(shared->size() == 10);
+        REQUIRE((*shared)[0].get_buf() == first.get_buf());
+    }
+
+    SECTION("clear releases everything") {
+        arena.clear();
+
+        REQUIRE(arena.empty());
+        REQUIRE(arena.bytes() == 0);
+    }
+}
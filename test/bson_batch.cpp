@@ -0,0 +1,47 @@
+#include "catch.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+#include "bson/batch.hpp"
+
+struct reading {
+    std::int32_t sensor;
+    double value;
+};
+
+MONGOCXX_BSON_MAPPING_BEGIN(reading)
+    MONGOCXX_BSON_FIELD(sensor)
+    MONGOCXX_BSON_FIELD(value)
+MONGOCXX_BSON_MAPPING_END()
+
+using namespace bson;
+
+TEST_CASE("encode_batch keeps record order", "[bson::encode_batch]") {
+    std::vector<reading> readings;
+
+    for (std::int32_t i = 0; i < 5000; i++) {
+        readings.push_back(reading{i, i * 0.5});
+    }
+
+    auto encode_reading = [](const reading& r, encoder& e) { return encode(r, e); };
+
+    encoded_batch batch = encode_batch(readings, encode_reading, 4);
+
+    REQUIRE(batch.size() == readings.size());
+
+    std::int32_t expected = 0;
+
+    for (auto&& doc : batch) {
+        REQUIRE(doc["sensor"].get_int32().value == expected++);
+    }
+
+    SECTION("errors on worker threads reach the caller") {
+        auto failing = [](const reading& r, encoder& e) {
+            if (r.sensor == 4000) throw std::runtime_error("bad reading");
+            return encode(r, e);
+        };
+
+        REQUIRE_THROWS(encode_batch(readings, failing, 4));
+    }
+}
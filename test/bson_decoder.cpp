@@ -0,0 +1,94 @@
+#include "catch.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bson/builder.hpp"
+#include "bson/decoder.hpp"
+#include "bson/encoder.hpp"
+
+struct account {
+    std::string owner;
+    std::int64_t balance;
+    std::vector<std::int32_t> history;
+    std::map<std::string, bool> flags;
+    mongo::driver::optional<std::string> nickname;
+};
+
+MONGOCXX_BSON_MAPPING_BEGIN(account)
+    MONGOCXX_BSON_FIELD(owner)
+    MONGOCXX_BSON_FIELD(balance)
+    MONGOCXX_BSON_FIELD(history)
+    MONGOCXX_BSON_FIELD(flags)
+    MONGOCXX_BSON_FIELD(nickname)
+MONGOCXX_BSON_MAPPING_END()
+
+using namespace bson;
+
+TEST_CASE("decoder round trips the encoder", "[bson::decoder]") {
+    account in;
+    in.owner = "alice";
+    in.balance = 100;
+    in.history = {1, 2, 3};
+    in.flags["frozen"] = false;
+    in.nickname = std::string{"al"};
+
+    document::value doc = encode(in);
+
+    account out;
+    decode_result result = decode(doc.view(), out);
+
+    REQUIRE(result);
+    REQUIRE(out.owner == "alice");
+    REQUIRE(out.balance == 100);
+    REQUIRE(out.history == in.history);
+    REQUIRE(out.flags == in.flags);
+    REQUIRE(out.nickname);
+    REQUIRE(*out.nickname == "al");
+}
+
+TEST_CASE("decoder reports problems without throwing", "[bson::decoder]") {
+    using namespace builder::helpers;
+
+    account out;
+
+    SECTION("fields may appear in any order and unknown keys are skipped") {
+        builder::document b;
+        b << "flags" << open_doc << close_doc << "extra" << 1 << "history" << open_array
+          << close_array << "balance" << 5 << "owner"
+          << "bob";
+
+        REQUIRE(decode(b.view(), out));
+        REQUIRE(out.owner == "bob");
+        REQUIRE(out.balance == 5);
+        REQUIRE(!out.nickname);
+    }
+
+    SECTION("missing fields are reported") {
+        builder::document b;
+        b << "owner"
+          << "bob";
+
+        decode_result result = decode(b.view(), out);
+
+        REQUIRE(!result);
+        REQUIRE(result.errors().size() == 3);
+        REQUIRE(std::string{result.errors()[0].key} == "balance");
+        REQUIRE(result.errors()[0].code == decode_error_code::k_missing);
+    }
+
+    SECTION("mistyped fields are reported") {
+        builder::document b;
+        b << "owner" << 1 << "balance" << 1.5 << "history" << open_array << close_array << "flags"
+          << open_doc << close_doc;
+
+        decode_result result = decode(b.view(), out);
+
+        REQUIRE(result.errors().size() == 2);
+        REQUIRE(std::string{result.errors()[0].key} == "owner");
+        REQUIRE(result.errors()[0].code == decode_error_code::k_type_mismatch);
+        REQUIRE(result.errors()[0].actual == type::k_int32);
+        REQUIRE(result.errors()[1].actual == type::k_double);
+    }
+}
@@ -0,0 +1,66 @@
+#include "catch.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "bson/builder.hpp"
+#include "bson/dump/reader.hpp"
+#include "bson/dump/writer.hpp"
+
+using namespace bson;
+
+TEST_CASE("dump files round trip through the writer and reader", "[bson::dump]") {
+    char path[] = "/tmp/mongocxx-dump-XXXXXX";
+    std::FILE* tmp = fdopen(mkstemp(path), "w");
+    std::fclose(tmp);
+
+    {
+        // A tiny buffer forces both buffered and direct writes.
+        dump::writer w(path, 64);
+
+        for (std::int32_t i = 0; i < 100; i++) {
+            builder::document b;
+            b << "i" << i << "pad" << std::string(i % 7 * 10, 'x');
+            w.write(b.view());
+        }
+
+        w.close();
+    }
+
+    dump::reader r(path);
+
+    SECTION("iterates every document in order") {
+        std::int32_t i = 0;
+
+        for (auto&& doc : r) {
+            REQUIRE(doc["i"].get_int32() == i);
+            i++;
+        }
+
+        REQUIRE(i == 100);
+    }
+
+    SECTION("splits at document boundaries") {
+        auto ranges = r.split(7);
+
+        REQUIRE(ranges.size() <= 7);
+
+        std::int32_t i = 0;
+        std::size_t bytes = 0;
+
+        for (auto&& range : ranges) {
+            bytes += range.size();
+
+            for (auto&& doc : range) {
+                REQUIRE(doc["i"].get_int32() == i);
+                i++;
+            }
+        }
+
+        REQUIRE(i == 100);
+        REQUIRE(bytes == r.size());
+    }
+
+    std::remove(path);
+}
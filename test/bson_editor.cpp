@@ -0,0 +1,71 @@
+#include "catch.hpp"
+
+#include <cstring>
+
+#include "bson/builder.hpp"
+#include "bson/document/editor.hpp"
+
+using namespace bson;
+
+TEST_CASE("editor overwrites and splices values", "[bson::document::editor]") {
+    using namespace builder::helpers;
+
+    builder::document b;
+    b << "count" << 1 << "name"
+      << "abc"
+      << "inner" << open_doc << "total" << 2.5 << "tags" << open_array << 1 << 2 << close_array
+      << close_doc << "last" << true;
+
+    document::value doc = b.extract();
+    document::editor editor{doc};
+
+    SECTION("fixed-width values are overwritten in place") {
+        const void* before = doc.view().get_buf();
+
+        REQUIRE(editor.set("count", types::b_int32{42}));
+        REQUIRE(editor.set("inner.total", types::b_double{7.0}));
+        REQUIRE(editor.set("inner.tags.1", types::b_int32{9}));
+
+        REQUIRE(doc.view().get_buf() == before);
+        REQUIRE(doc.view()["count"].get_int32().value == 42);
+        REQUIRE(doc.view()["inner"].get_document().value["total"].get_double().value == 7.0);
+    }
+
+    SECTION("resized values update the enclosing lengths") {
+        REQUIRE(editor.set("inner.total", types::b_utf8{"a much longer string"}));
+        REQUIRE(editor.set("name", types::b_null{}));
+
+        builder::document expected;
+        expected << "count" << 1 << "name" << types::b_null{} << "inner" << open_doc << "total"
+                 << "a much longer string"
+                 << "tags" << open_array << 1 << 2 << close_array << close_doc << "last" << true;
+
+        REQUIRE(doc.view().get_len() == expected.view().get_len());
+        REQUIRE(std::memcmp(doc.view().get_buf(), expected.view().get_buf(),
+                            expected.view().get_len()) == 0);
+    }
+
+    SECTION("values may be copied from the document being edited") {
+        REQUIRE(editor.set("count", doc.view()["inner"]));
+        REQUIRE(editor.set("last", doc.view()["name"]));
+        REQUIRE(editor.set("count.total", doc.view()["count"].get_document().value["tags"]));
+
+        builder::document expected;
+        expected << "count" << open_doc << "total" << open_array << 1 << 2 << close_array << "tags"
+                 << open_array << 1 << 2 << close_array << close_doc << "name"
+                 << "abc"
+                 << "inner" << open_doc << "total" << 2.5 << "tags" << open_array << 1 << 2
+                 << close_array << close_doc << "last"
+                 << "abc";
+
+        REQUIRE(doc.view().get_len() == expected.view().get_len());
+        REQUIRE(std::memcmp(doc.view().get_buf(), expected.view().get_buf(),
+                            expected.view().get_len()) == 0);
+    }
+
+    SECTION("missing paths are left alone") {
+        REQUIRE(!editor.set("nope", types::b_int32{1}));
+        REQUIRE(!editor.set("count.deeper", types::b_int32{1}));
+        REQUIRE(doc.view()["count"].get_int32().value == 1);
+    }
+}
@@ -0,0 +1,98 @@
+#include "catch.hpp"
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bson/builder.hpp"
+#include "bson/encoder.hpp"
+
+struct point {
+    std::int32_t x;
+    std::int32_t y;
+};
+
+struct shape {
+    std::string name;
+    point origin;
+    std::vector<point> vertices;
+    std::map<std::string, double> tags;
+    mongo::driver::optional<std::int64_t> area;
+    bool visible;
+};
+
+MONGOCXX_BSON_MAPPING_BEGIN(point)
+    MONGOCXX_BSON_FIELD(x)
+    MONGOCXX_BSON_FIELD(y)
+MONGOCXX_BSON_MAPPING_END()
+
+MONGOCXX_BSON_MAPPING_BEGIN(shape)
+    MONGOCXX_BSON_FIELD_NAMED(name, "_name")
+    MONGOCXX_BSON_FIELD(origin)
+    MONGOCXX_BSON_FIELD(vertices)
+    MONGOCXX_BSON_FIELD(tags)
+    MONGOCXX_BSON_FIELD(area)
+    MONGOCXX_BSON_FIELD(visible)
+MONGOCXX_BSON_MAPPING_END()
+
+using namespace bson;
+
+void bson_eq_view(const document::view& expected, const document::view& test) {
+    INFO("expected = " << expected);
+    INFO("encoded = " << test);
+    REQUIRE(expected.get_len() == test.get_len());
+    REQUIRE(std::memcmp(expected.get_buf(), test.get_buf(), expected.get_len()) == 0);
+}
+
+TEST_CASE("encoder matches the builder for flat structs", "[bson::encoder]") {
+    builder::document b;
+    b << "x" << 1 << "y" << 2;
+
+    point p{1, 2};
+
+    SECTION("one-shot encode") {
+        document::value v = encode(p);
+        bson_eq_view(b.view(), v.view());
+    }
+
+    SECTION("encode into a reused encoder") {
+        encoder e;
+        encode(point{3, 4}, e);
+        bson_eq_view(b.view(), encode(p, e));
+    }
+}
+
+TEST_CASE("encoder recurses into nested structs and containers", "[bson::encoder]") {
+    using namespace builder::helpers;
+
+    shape s;
+    s.name = "triangle";
+    s.origin = point{0, 0};
+    s.vertices = {point{0, 0}, point{1, 0}, point{0, 1}};
+    s.tags["weight"] = 1.5;
+    s.visible = true;
+
+    builder::document b;
+    b << "_name" << "triangle"
+      << "origin" << open_doc << "x" << 0 << "y" << 0 << close_doc
+      << "vertices" << open_array
+          << open_doc << "x" << 0 << "y" << 0 << close_doc
+          << open_doc << "x" << 1 << "y" << 0 << close_doc
+          << open_doc << "x" << 0 << "y" << 1 << close_doc
+      << close_array
+      << "tags" << open_doc << "weight" << 1.5 << close_doc;
+
+    SECTION("disengaged optionals are omitted") {
+        b << "visible" << true;
+
+        bson_eq_view(b.view(), encode(s).view());
+    }
+
+    SECTION("engaged optionals are written") {
+        s.area = std::int64_t{10};
+        b << "area" << std::int64_t{10} << "visible" << true;
+
+        bson_eq_view(b.view(), encode(s).view());
+    }
+}
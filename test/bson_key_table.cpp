@@ -0,0 +1,43 @@
+#include "catch.hpp"
+
+#include <string>
+
+#include "bson/key_table.hpp"
+
+using namespace bson;
+
+TEST_CASE("key_table interns keys densely", "[bson::key_table]") {
+    key_table table;
+
+    for (int i = 0; i < 100; i++) {
+        std::string key = "field" + std::to_string(i);
+
+        REQUIRE(table.intern(key.c_str(), key.length()) == static_cast<key_table::id_type>(i));
+    }
+
+    REQUIRE(table.size() == 100);
+    REQUIRE(table.intern("field7", 6) == 7);
+    REQUIRE(table.find("field42", 7) == 42);
+    REQUIRE(table.find("field", 5) == key_table::k_npos);
+    REQUIRE(table.key(3) == "field3");
+
+    REQUIRE(table.matches(1, "field1"));
+    REQUIRE(!table.matches(1, "field"));
+    REQUIRE(!table.matches(1, "field10"));
+}
+
+TEST_CASE("key_table::order recognizes repeated layouts", "[bson::key_table]") {
+    key_table table;
+    table.intern("a", 1);
+    table.intern("b", 1);
+
+    key_table::order order{&table};
+
+    REQUIRE(order.find(0, "a") == 0);
+    REQUIRE(order.find(1, "b") == 1);
+    REQUIRE(order.find(2, "c") == key_table::k_npos);
+
+    REQUIRE(order.find(0, "a") == 0);
+    REQUIRE(order.find(1, "a") == 0);
+    REQUIRE(order.find(0, "b") == 1);
+}
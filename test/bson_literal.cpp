@@ -0,0 +1,32 @@
+#include "catch.hpp"
+
+#include <cstring>
+
+#include "bson/builder.hpp"
+#include "bson/literal.hpp"
+
+using namespace bson;
+
+namespace {
+
+constexpr auto k_stage = literal::doc(
+    literal::field("$match", literal::doc(literal::field("name", "abc"), literal::field("n", 1))),
+    literal::field("big", std::int64_t{1} << 40), literal::field("flag", true),
+    literal::field("none", literal::null), literal::field("empty", literal::doc()));
+
+}  // namespace
+
+TEST_CASE("literal documents match the builder", "[bson::literal]") {
+    using namespace builder::helpers;
+
+    builder::document b;
+    b << "$match" << open_doc << "name"
+      << "abc"
+      << "n" << 1 << close_doc << "big" << (std::int64_t{1} << 40) << "flag" << true << "none"
+      << types::b_null{} << "empty" << open_doc << close_doc;
+
+    document::view view = k_stage.view();
+
+    REQUIRE(view.get_len() == b.view().get_len());
+    REQUIRE(std::memcmp(view.get_buf(), b.view().get_buf(), view.get_len()) == 0);
+}
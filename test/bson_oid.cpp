@@ -0,0 +1,35 @@
+#include "catch.hpp"
+
+#include <string>
+#include <unordered_set>
+
+#include "bson/oid.hpp"
+#include "bson/string_or_literal.hpp"
+
+using namespace bson;
+
+TEST_CASE("oid round trips through hex", "[bson::oid]") {
+    oid id{"507f1f77bcf86cd799439011"};
+
+    REQUIRE(id);
+    REQUIRE(std::string{id.to_string().c_str()} == "507f1f77bcf86cd799439011");
+    REQUIRE(id.get_time_t() == 0x507f1f77);
+    REQUIRE(oid{"507F1F77BCF86CD799439011"} == id);
+
+    REQUIRE(!oid{"507f1f77bcf86cd79943901"});
+    REQUIRE(!oid{"507f1f77bcf86cd79943901g"});
+}
+
+TEST_CASE("oid generation", "[bson::oid]") {
+    oid ids[64];
+    oid::generate(ids, 64);
+
+    std::unordered_set<oid> seen{std::begin(ids), std::end(ids)};
+    seen.insert(oid{oid::init_tag});
+
+    REQUIRE(seen.size() == 65);
+
+    for (auto&& id : ids) {
+        REQUIRE(id < oid{oid::init_tag});
+    }
+}
@@ -0,0 +1,53 @@
+#include "catch.hpp"
+
+#include <vector>
+
+#include "bson/builder.hpp"
+#include "bson/packed_vector.hpp"
+
+using namespace bson;
+
+TEST_CASE("packed vectors round trip through documents", "[bson::packed_vector]") {
+    std::vector<float> values{0.5f, -1.25f, 3.0f};
+    packed_vector packed = packed_vector::pack(values);
+
+    builder::document b;
+    b << "v" << packed.binary();
+
+    types::b_binary binary = b.view()["v"].get_binary();
+
+    REQUIRE(binary.sub_type == binary_sub_type::k_vector);
+    REQUIRE(binary.size == 2 + 3 * sizeof(float));
+
+    auto span = packed_span<float>::from(binary);
+
+    REQUIRE(span);
+    REQUIRE(span->size() == 3);
+    REQUIRE((*span)[1] == -1.25f);
+
+    std::vector<float> copy(span->size());
+    span->copy_to(copy.data());
+
+    REQUIRE(copy == values);
+
+    REQUIRE(!packed_span<double>::from(binary));
+    REQUIRE(!packed_span<std::int8_t>::from(binary));
+}
+
+TEST_CASE("packed vectors without a published dtype use the user-defined subtype",
+          "[bson::packed_vector]") {
+    std::vector<double> values{1.0, -2.0};
+    packed_vector packed = packed_vector::pack(values);
+
+    builder::document b;
+    b << "v" << packed.binary();
+
+    types::b_binary binary = b.view()["v"].get_binary();
+
+    REQUIRE(binary.sub_type == binary_sub_type::k_user);
+
+    auto span = packed_span<double>::from(binary);
+
+    REQUIRE(span);
+    REQUIRE((*span)[1] == -2.0);
+}
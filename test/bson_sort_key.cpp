@@ -0,0 +1,73 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "bson/builder.hpp"
+#include "bson/sort_key.hpp"
+
+using namespace bson;
+
+TEST_CASE("sort keys order like the server", "[bson::sort_key_encoder]") {
+    using namespace builder::helpers;
+
+    builder::document spec;
+    spec << "a" << 1;
+
+    sort_key_encoder encoder{spec.view()};
+
+    std::vector<builder::document> docs(7);
+    docs[0] << "b" << 1;
+    docs[1] << "a" << -2.5;
+    docs[2] << "a" << 1;
+    docs[3] << "a" << std::int64_t{2};
+    docs[4] << "a" << 2.5;
+    docs[5] << "a"
+            << "";
+    docs[6] << "a"
+            << "a";
+
+    std::vector<std::string> keys;
+
+    for (auto&& doc : docs) {
+        keys.push_back(encoder.encode(doc.view()));
+    }
+
+    REQUIRE(std::is_sorted(keys.begin(), keys.end()));
+
+    SECTION("numbers compare across types") {
+        builder::document a, b, c;
+        a << "a" << 1;
+        b << "a" << std::int64_t{1};
+        c << "a" << 1.0;
+
+        REQUIRE(encoder.encode(a.view()) == encoder.encode(b.view()));
+        REQUIRE(encoder.encode(a.view()) == encoder.encode(c.view()));
+    }
+
+    SECTION("large int64 values do not collapse onto doubles") {
+        builder::document a, b;
+        a << "a" << (std::int64_t{1} << 60) + 1;
+        b << "a" << static_cast<double>(std::int64_t{1} << 60);
+
+        REQUIRE(encoder.encode(b.view()) < encoder.encode(a.view()));
+    }
+}
+
+TEST_CASE("sort keys handle paths and descending fields", "[bson::sort_key_encoder]") {
+    using namespace builder::helpers;
+
+    builder::document spec;
+    spec << "x.y" << -1 << "z" << 1;
+
+    sort_key_encoder encoder{spec.view()};
+
+    builder::document a, b, c;
+    a << "x" << open_doc << "y" << 5 << close_doc << "z" << 1;
+    b << "x" << open_doc << "y" << 5 << close_doc << "z" << 2;
+    c << "x" << open_doc << "y" << 3 << close_doc << "z" << 0;
+
+    REQUIRE(encoder.encode(a.view()) < encoder.encode(b.view()));
+    REQUIRE(encoder.encode(b.view()) < encoder.encode(c.view()));
+}
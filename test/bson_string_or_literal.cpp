@@ -136,3 +136,22 @@ TEST_CASE("string_or_literal construction from a string string_or_literal works"
         ensure_string_or_literal(val, "");
     }
 }
+
+TEST_CASE("string_or_literal only owns when asked to", "[bson::string_or_literal]") {
+    using namespace bson;
+
+    std::string str("foo");
+
+    string_or_literal borrowed(str);
+
+    REQUIRE(!borrowed.is_owning());
+    REQUIRE(borrowed.c_str() == str.c_str());
+
+    string_or_literal owned = borrowed.to_owned();
+
+    REQUIRE(owned.is_owning());
+    REQUIRE(owned.c_str() != str.c_str());
+    ensure_string_or_literal(owned, "foo");
+
+    REQUIRE(string_or_literal(std::move(str)).is_owning());
+}
@@ -0,0 +1,89 @@
+#include "catch.hpp"
+
+#include <cstring>
+
+#include "bson/builder.hpp"
+#include "bson/update.hpp"
+
+using namespace bson;
+
+namespace {
+
+void require_equal(const document::view& actual, const document::view& expected) {
+    REQUIRE(actual.get_len() == expected.get_len());
+    REQUIRE(std::memcmp(actual.get_buf(), expected.get_buf(), expected.get_len()) == 0);
+}
+
+}  // namespace
+
+TEST_CASE("apply_update applies update operators locally", "[bson::apply_update]") {
+    using namespace builder::helpers;
+
+    builder::document b;
+    b << "n" << 1 << "big" << 2147483647 << "name"
+      << "x"
+      << "sub" << open_doc << "score" << 2.5 << close_doc << "tags" << open_array << "a"
+      << "b" << close_array;
+
+    document::value doc = b.extract();
+
+    SECTION("existing fields are edited in place") {
+        builder::document update;
+        update << "$inc" << open_doc << "n" << 2 << "big" << 1 << close_doc << "$max" << open_doc
+               << "sub.score" << 10 << close_doc << "$set" << open_doc << "name"
+               << "y" << close_doc;
+
+        apply_update(doc, update.view());
+
+        builder::document expected;
+        expected << "n" << 3 << "big" << std::int64_t{2147483648} << "name"
+                 << "y"
+                 << "sub" << open_doc << "score" << 10 << close_doc << "tags" << open_array << "a"
+                 << "b" << close_array;
+
+        require_equal(doc.view(), expected.view());
+    }
+
+    SECTION("structural changes rewrite the document") {
+        builder::document update;
+        update << "$unset" << open_doc << "name" << 1 << close_doc << "$set" << open_doc
+               << "sub.new.deep" << true << close_doc << "$addToSet" << open_doc << "tags"
+               << open_doc << "$each" << open_array << "b"
+               << "c" << close_array << close_doc << close_doc << "$pull" << open_doc << "tags"
+               << "a" << close_doc << "$mul" << open_doc << "missing" << 3.0 << close_doc;
+
+        REQUIRE_THROWS(apply_update(doc, update.view()));
+
+        builder::document fixed;
+        fixed << "$unset" << open_doc << "name" << 1 << close_doc << "$set" << open_doc
+              << "sub.new.deep" << true << close_doc << "$push" << open_doc << "tags"
+              << open_doc << "$each" << open_array << "b"
+              << "c" << close_array << close_doc << close_doc << "$mul" << open_doc << "missing"
+              << 3.0 << close_doc;
+
+        apply_update(doc, fixed.view());
+
+        builder::document expected;
+        expected << "n" << 1 << "big" << 2147483647 << "sub" << open_doc << "score" << 2.5 << "new"
+                 << open_doc << "deep" << true << close_doc << close_doc << "tags" << open_array
+                 << "a"
+                 << "b"
+                 << "b"
+                 << "c" << close_array << "missing" << 0.0;
+
+        require_equal(doc.view(), expected.view());
+    }
+
+    SECTION("failures leave the document unchanged") {
+        builder::document update;
+        update << "$set" << open_doc << "n" << 5 << close_doc << "$inc" << open_doc << "name" << 1
+               << close_doc;
+
+        document::view before = doc.view();
+        std::size_t len = before.get_len();
+
+        REQUIRE_THROWS(apply_update(doc, update.view()));
+        REQUIRE(doc.view().get_len() == len);
+        REQUIRE(doc.view()["n"].get_int32().value == 1);
+    }
+}
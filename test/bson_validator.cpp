@@ -0,0 +1,63 @@
+#include "catch.hpp"
+
+#include <string>
+
+#include "bson/builder.hpp"
+#include "bson/validator.hpp"
+
+using namespace bson;
+
+TEST_CASE("validator checks documents against a compiled schema", "[bson::validator]") {
+    using namespace builder::helpers;
+
+    builder::document schema;
+    schema << "required" << open_array << "name"
+           << "age" << close_array << "additionalProperties" << false << "properties" << open_doc
+           << "name" << open_doc << "bsonType"
+           << "string"
+           << "minLength" << 1 << "maxLength" << 8 << close_doc << "age" << open_doc << "bsonType"
+           << "number"
+           << "minimum" << 0 << "maximum" << 150 << close_doc << "tags" << open_doc << "bsonType"
+           << "array"
+           << "maxItems" << 2 << "items" << open_doc << "bsonType"
+           << "string" << close_doc << close_doc << close_doc;
+
+    validator v{schema.view()};
+
+    SECTION("valid documents pass") {
+        builder::document doc;
+        doc << "name"
+            << "ann"
+            << "age" << 30.5 << "tags" << open_array << "a" << close_array;
+
+        REQUIRE(v.validate(doc.view()));
+    }
+
+    SECTION("every problem is reported") {
+        builder::document doc;
+        doc << "name"
+            << ""
+            << "tags" << open_array << "a" << 1 << "c" << close_array << "extra" << true;
+
+        validation_result result = v.validate(doc.view());
+
+        REQUIRE(result.size() == 5);
+        REQUIRE(std::string{result[0].path} == "name");
+        REQUIRE(result[0].code == validation_error_code::k_min_length);
+        REQUIRE(std::string{result[1].path} == "tags.$");
+        REQUIRE(result[1].code == validation_error_code::k_type);
+        REQUIRE(result[1].actual == type::k_int32);
+        REQUIRE(result[2].code == validation_error_code::k_max_items);
+        REQUIRE(result[3].code == validation_error_code::k_unexpected);
+        REQUIRE(std::string{result[4].path} == "age");
+        REQUIRE(result[4].code == validation_error_code::k_missing);
+    }
+
+    SECTION("unsupported keywords are rejected") {
+        builder::document bad;
+        bad << "pattern"
+            << "^a";
+
+        REQUIRE_THROWS(validator{bad.view()});
+    }
+}
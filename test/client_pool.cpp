@@ -0,0 +1,74 @@
+#include "catch.hpp"
+
+#include "bson/builder.hpp"
+#include "mongocxx.hpp"
+
+using namespace mongo::driver;
+
+TEST_CASE("client pool hands out leases", "[driver::client_pool]") {
+    mongoc_init();
+    client_pool pool;
+    pool.max_size(1);
+
+    SECTION("try_acquire refuses when the pool is exhausted") {
+        {
+            optional<client> first = pool.try_acquire();
+            REQUIRE(first);
+            REQUIRE(!pool.try_acquire());
+        }
+
+        REQUIRE(pool.try_acquire());
+
+        client_pool_stats stats = pool.stats();
+        REQUIRE(stats.acquired == 2);
+        REQUIRE(stats.refused == 1);
+        REQUIRE(stats.waited == 0);
+    }
+
+    SECTION("leased clients reach the server") {
+        client mongodb_client = pool.acquire();
+        database db = mongodb_client["test"];
+        collection coll = db["mongo-cxx-driver"];
+        coll.drop();
+
+        bson::builder::document b;
+        b << "x" << 1;
+        coll.insert_one(b.view());
+
+        REQUIRE(coll.count() == 1);
+    }
+
+    SECTION("warm_up stops when the pool is exhausted") {
+        result::warm_up report =
+            pool.warm_up(2, std::chrono::steady_clock::now() + std::chrono::seconds{10});
+
+        REQUIRE(!report.is_complete);
+        REQUIRE(report.connections == 1);
+        REQUIRE(report.discovery > std::chrono::nanoseconds{0});
+
+        // Warming up is not load, so it leaves the statistics alone.
+        client_pool_stats stats = pool.stats();
+        REQUIRE(stats.acquired == 0);
+        REQUIRE(stats.refused == 0);
+    }
+}
+
+TEST_CASE("sharded client pool steals from other shards", "[driver::sharded_client_pool]") {
+    mongoc_init();
+    sharded_client_pool pool{"mongodb://localhost:27017", 2};
+    pool.max_size(2);
+
+    REQUIRE(pool.shards() == 2);
+
+    client first = pool.acquire();
+    client second = pool.acquire();
+
+    // Unless the thread migrated between the two, the second came from the other shard.
+    REQUIRE(pool.stolen() <= 1);
+    REQUIRE(!pool.try_acquire());
+
+    client_pool_stats stats = pool.stats();
+    REQUIRE(stats.acquired == 2);
+    REQUIRE(stats.waited == 0);
+    REQUIRE(stats.refused == 1);
+}
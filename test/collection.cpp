@@ -54,6 +54,101 @@ TEST_CASE("CRUD functionality", "[driver::collection]") {
         REQUIRE(sum == 3);
     }
 
+    SECTION("prefetching cursor reads every document", "[collection]") {
+        std::vector<bson::builder::document> docs(100);
+        std::vector<bson::document::view> inserts;
+
+        for (std::int32_t i = 0; i < 100; i++) {
+            docs[i] << "_id" << i;
+            inserts.push_back(docs[i].view());
+        }
+
+        coll.insert_many(inserts);
+
+        auto cursor = coll.find();
+        cursor.prefetch(2, 256);
+
+        std::int32_t sum = 0;
+        for (auto&& doc : cursor) {
+            sum += doc["_id"].get_int32();
+        }
+
+        REQUIRE(sum == 4950);
+        REQUIRE_THROWS(cursor.prefetch(2, 256));
+    }
+
+    SECTION("cursor reads in batches", "[collection]") {
+        std::vector<bson::builder::document> docs(25);
+        std::vector<bson::document::view> inserts;
+
+        for (std::int32_t i = 0; i < 25; i++) {
+            docs[i] << "_id" << i;
+            inserts.push_back(docs[i].view());
+        }
+
+        coll.insert_many(inserts);
+
+        auto cursor = coll.find();
+
+        std::size_t batches = 0;
+        std::size_t count = 0;
+
+        for (;;) {
+            const auto& batch = cursor.next_batch(10);
+
+            if (batch.empty()) {
+                break;
+            }
+
+            std::size_t length = 0;
+
+            for (auto&& doc : batch) {
+                length += doc.get_len();
+            }
+
+            REQUIRE(length == batch.length());
+
+            batches++;
+            count += batch.size();
+        }
+
+        REQUIRE(batches == 3);
+        REQUIRE(count == 25);
+    }
+
+    SECTION("zero batch limits still read one document", "[collection]") {
+        for (std::int32_t i = 0; i < 3; i++) {
+            bson::builder::document b;
+            b << "_id" << i;
+            coll.insert_one(b.view());
+        }
+
+        auto cursor = coll.find();
+
+        REQUIRE(cursor.next_batch(0).size() == 1);
+        REQUIRE(cursor.next_batch(10, 0).size() == 1);
+        REQUIRE(cursor.next_shared_batch(0)->size() == 1);
+        REQUIRE(cursor.next_batch(0).empty());
+    }
+
+    SECTION("pinned documents outlive the cursor", "[collection]") {
+        bson::builder::document b;
+        b << "_id" << 1;
+        coll.insert_one(b.view());
+
+        std::shared_ptr<const bson::document::view> pinned;
+
+        {
+            auto cursor = coll.find();
+            auto batch = cursor.next_shared_batch();
+
+            REQUIRE(batch->size() == 1);
+            pinned = cursor::batch::pin(batch, 0);
+        }
+
+        REQUIRE((*pinned)["_id"].get_int32() == 1);
+    }
+
     SECTION("insert and update single document", "[collection]") {
         using namespace bson::builder::helpers;
         bson::builder::document b1;
@@ -401,4 +496,41 @@ TEST_CASE("CRUD functionality", "[driver::collection]") {
         model::aggregate aggregation(std::move(p));
         auto results = coll.aggregate(aggregation);
     }
+
+    SECTION("aggregate with a bound pipeline template", "[collection]") {
+        using namespace bson::builder::helpers;
+
+        bson::builder::document b1;
+        b1 << "x" << 1;
+
+        bson::builder::document b2;
+        b2 << "x" << 2;
+
+        coll.insert_one(b1.view());
+        coll.insert_one(b2.view());
+        coll.insert_one(b2.view());
+
+        bson::builder::document criteria;
+        criteria << "x" << open_doc << "$param"
+                 << "x" << close_doc;
+
+        pipeline p;
+        p.match(criteria.view());
+
+        pipeline_template shape{p};
+        REQUIRE(shape.slots() == 1);
+
+        bson::builder::document params;
+        params << "x" << 2;
+
+        auto results = coll.aggregate(model::aggregate{shape.bind(params.view())});
+
+        std::size_t i = 0;
+        for (auto&& x : results) {
+            REQUIRE(x["x"].get_int32() == 2);
+            i++;
+        }
+
+        REQUIRE(i == 2);
+    }
 }
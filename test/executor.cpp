@@ -0,0 +1,151 @@
+#include "catch.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <vector>
+
+#include "bson/builder.hpp"
+#include "mongocxx.hpp"
+
+using namespace mongo::driver;
+
+TEST_CASE("executor runs collection operations in the background", "[driver::executor]") {
+    mongoc_init();
+    client_pool pool;
+    executor workers{pool, 2, 16};
+    async_collection coll = workers.collection("test", "mongo-cxx-driver-async");
+
+    {
+        client mongodb_client = pool.acquire();
+        database db = mongodb_client["test"];
+        db["mongo-cxx-driver-async"].drop();
+    }
+
+    bson::builder::document b;
+    b << "x" << 1;
+
+    SECTION("operations complete their futures") {
+        std::vector<std::future<result::insert_one>> inserts;
+
+        for (int i = 0; i < 4; i++) {
+            inserts.push_back(coll.insert_one_async(model::insert_one{b.view()}));
+        }
+
+        for (auto&& insert : inserts) {
+            REQUIRE(insert.get().is_acknowledged);
+        }
+
+        REQUIRE(coll.count_async().get() == 4);
+        REQUIRE(coll.find_async().get().size() == 4);
+
+        async_cursor docs = coll.find_cursor();
+        std::size_t i = 0;
+
+        while (optional<bson::document::view> doc = docs.next().get()) {
+            REQUIRE((*doc)["x"].get_int32() == 1);
+            i++;
+        }
+
+        REQUIRE(i == 4);
+    }
+
+    SECTION("cursors hand batches to the workers") {
+        client mongodb_client = pool.acquire();
+        database db = mongodb_client["test"];
+        collection sync_coll = db["mongo-cxx-driver-async"];
+
+        // Ten times the default batch of 1000 documents, so that batches queue up behind
+        // max_in_flight and spread over both workers.
+        std::vector<bson::builder::document> docs(10000);
+        std::vector<bson::document::view> inserts;
+
+        for (std::int32_t i = 0; i < 10000; i++) {
+            docs[i] << "_id" << i;
+            inserts.push_back(docs[i].view());
+        }
+
+        sync_coll.insert_many(inserts);
+
+        std::vector<std::int32_t> expected;
+
+        for (auto&& doc : sync_coll.find()) {
+            expected.push_back(doc["_id"].get_int32());
+        }
+
+        REQUIRE(expected.size() == 10000);
+
+        std::atomic<std::int64_t> sum{0};
+        std::atomic<std::int64_t> count{0};
+        auto results = sync_coll.find();
+        results.parallel_for_each(workers, [&](const bson::document::view& doc) {
+            sum += doc["_id"].get_int32();
+            count++;
+        }, for_each_mode::k_unordered, 2);
+
+        REQUIRE(count == 10000);
+        REQUIRE(sum == 49995000);
+
+        std::vector<std::int32_t> ordered;
+        results = sync_coll.find();
+        results.parallel_for_each(workers, [&](const bson::document::view& doc) {
+            ordered.push_back(doc["_id"].get_int32());
+        }, for_each_mode::k_ordered, 2);
+
+        REQUIRE(ordered == expected);
+
+        struct stop {};
+
+        auto stop_midway = [](const bson::document::view& doc) {
+            if (doc["_id"].get_int32() == 4321) {
+                throw stop{};
+            }
+        };
+
+        for (auto mode : {for_each_mode::k_ordered, for_each_mode::k_unordered}) {
+            results = sync_coll.find();
+            REQUIRE_THROWS_AS(results.parallel_for_each(workers, stop_midway, mode, 2), stop);
+        }
+
+        // A task on a one thread executor has no other worker to hand its batches to.
+        executor single{pool, 1, 4};
+
+        for (auto mode : {for_each_mode::k_ordered, for_each_mode::k_unordered}) {
+            std::int64_t nested = 0;
+
+            single.run_async([&](client& c) {
+                database task_db = c["test"];
+                collection task_coll = task_db["mongo-cxx-driver-async"];
+                auto task_results = task_coll.find();
+                task_results.parallel_for_each(single, [&](const bson::document::view& doc) {
+                    nested += doc["_id"].get_int32();
+                }, mode, 2);
+            }).get();
+
+            REQUIRE(nested == 49995000);
+        }
+    }
+
+    SECTION("cancelled operations fail without running") {
+        cancellation token;
+        token.cancel();
+
+        auto insert = coll.insert_one_async(model::insert_one{b.view()}, token);
+
+        REQUIRE_THROWS(insert.get());
+        REQUIRE(coll.count_async().get() == 0);
+    }
+}
+
+TEST_CASE("executor fails fast when it cannot start", "[driver::executor]") {
+    mongoc_init();
+    client_pool pool;
+    pool.max_size(1);
+
+    REQUIRE_THROWS(executor(pool, 1, 0));
+    REQUIRE_THROWS(executor(pool, 2, 16));
+
+    // The failed constructor returned its lease, so one worker still fits.
+    executor workers{pool, 1, 16};
+    REQUIRE(!pool.try_acquire());
+}
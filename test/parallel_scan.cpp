@@ -0,0 +1,89 @@
+#include "catch.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "bson/builder.hpp"
+#include "mongocxx.hpp"
+
+using namespace mongo::driver;
+
+TEST_CASE("parallel scan reads every document once", "[driver::parallel_scan]") {
+    mongoc_init();
+    client_pool pool;
+
+    {
+        client mongodb_client = pool.acquire();
+        database db = mongodb_client["test"];
+        collection coll = db["mongo-cxx-driver-scan"];
+        coll.drop();
+
+        std::vector<bson::builder::document> docs(1000);
+        std::vector<bson::document::view> inserts;
+
+        for (std::int32_t i = 0; i < 1000; i++) {
+            docs[i] << "_id" << i;
+            inserts.push_back(docs[i].view());
+        }
+
+        coll.insert_many(inserts);
+    }
+
+    parallel_scan scan{pool, "test", "mongo-cxx-driver-scan", 4};
+
+    // 64 samples of 1000 distinct _ids can only collapse to one split if sampling failed.
+    REQUIRE(scan.partitions() > 1);
+    REQUIRE(scan.partitions() <= 4);
+
+    SECTION("partitions are disjoint and cover the collection") {
+        client mongodb_client = pool.acquire();
+        database db = mongodb_client["test"];
+        collection coll = db["mongo-cxx-driver-scan"];
+
+        std::set<std::int32_t> seen;
+        std::size_t total = 0;
+
+        for (std::size_t i = 0; i < scan.partitions(); i++) {
+            std::size_t count = 0;
+
+            for (auto&& doc : coll.find(scan.partition(i))) {
+                seen.insert(doc["_id"].get_int32());
+                count++;
+            }
+
+            REQUIRE(count > 0);
+            total += count;
+        }
+
+        REQUIRE(total == 1000);
+        REQUIRE(seen.size() == 1000);
+    }
+
+    SECTION("for_each hands each partition to its own thread") {
+        std::atomic<std::int64_t> sum{0};
+        std::atomic<std::int64_t> count{0};
+
+        scan.for_each([&](std::size_t, const bson::document::view& doc) {
+            sum += doc["_id"].get_int32();
+            count++;
+        });
+
+        REQUIRE(count == 1000);
+        REQUIRE(sum == 499500);
+    }
+
+    SECTION("merge streams every partition to the caller") {
+        std::int64_t sum = 0;
+        std::int64_t count = 0;
+
+        scan.merge([&](const bson::document::view& doc) {
+            sum += doc["_id"].get_int32();
+            count++;
+        });
+
+        REQUIRE(count == 1000);
+        REQUIRE(sum == 499500);
+    }
+}
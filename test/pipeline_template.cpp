@@ -0,0 +1,79 @@
+#include "catch.hpp"
+
+#include <cstring>
+
+#include "bson/builder.hpp"
+#include "driver/base/pipeline.hpp"
+#include "driver/base/pipeline_template.hpp"
+
+using namespace mongo::driver;
+
+TEST_CASE("pipeline_template patches the lengths around bound slots", "[pipeline_template]") {
+    using namespace bson::builder::helpers;
+    using bson::types::b_document;
+
+    bson::builder::document criteria;
+    criteria << "a" << open_doc << "$param"
+             << "a" << close_doc << "nested" << open_doc << "list" << open_array << 1 << open_doc
+             << "$param"
+             << "b" << close_doc << 3 << close_array << "c" << open_doc << "$param"
+             << "c" << close_doc << close_doc << "after" << true;
+
+    pipeline stages;
+    stages.match(criteria.view()).limit(5);
+
+    pipeline_template shape{stages};
+    REQUIRE(shape.slots() == 3);
+
+    bson::builder::document sub;
+    sub << "x" << 1 << "y"
+        << "a longer value than the placeholder";
+
+    // a grows, b shrinks to an int32 and c grows to a larger document.
+    bson::builder::document params;
+    params << "c" << b_document{sub.view()} << "b" << 2 << "a"
+           << "some string of some length";
+
+    bson::builder::document expected_criteria;
+    expected_criteria << "a"
+                      << "some string of some length"
+                      << "nested" << open_doc << "list" << open_array << 1 << 2 << 3
+                      << close_array << "c" << b_document{sub.view()} << close_doc << "after"
+                      << true;
+
+    pipeline expected;
+    expected.match(expected_criteria.view()).limit(5);
+
+    pipeline bound = shape.bind(params.view());
+
+    bson::document::view got = bound.view_array();
+    bson::document::view want = expected.view_array();
+
+    REQUIRE(got.get_len() == want.get_len());
+    REQUIRE(std::memcmp(got.get_buf(), want.get_buf(), want.get_len()) == 0);
+
+    SECTION("binding again starts from the template") {
+        bson::builder::document small;
+        small << "a" << 0 << "b" << 0 << "c" << 0;
+
+        pipeline rebound = shape.bind(small.view());
+
+        bson::builder::document zeros;
+        zeros << "a" << 0 << "nested" << open_doc << "list" << open_array << 1 << 0 << 3
+              << close_array << "c" << 0 << close_doc << "after" << true;
+
+        pipeline expected_zeros;
+        expected_zeros.match(zeros.view()).limit(5);
+
+        REQUIRE(rebound.view_array().get_len() == expected_zeros.view_array().get_len());
+        REQUIRE(std::memcmp(rebound.view_array().get_buf(), expected_zeros.view_array().get_buf(),
+                            expected_zeros.view_array().get_len()) == 0);
+    }
+
+    SECTION("missing parameters are rejected") {
+        bson::builder::document partial;
+        partial << "a" << 1;
+
+        REQUIRE_THROWS(shape.bind(partial.view()));
+    }
+}